@@ -29,6 +29,13 @@ extern "C" {
 #define EB_BUFFERFLAG_TG            0x00000004  // signals that the packet contains Tile Group header
 #endif
 
+// Memory buffer, used to pass the first pass statistics of a two pass encode
+typedef struct EbSvtAv1FixedBuf
+{
+    void                    *buf;
+    uint64_t                 sz;
+} EbSvtAv1FixedBuf;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration
@@ -82,6 +89,12 @@ typedef struct EbSvtAv1EncConfiguration
      * In Random Access structure, the B/b pictures can refer to reference pictures
      * from both directions (past and future).
      *
+     * 0 = Low Delay P: flat IPPP structure for real time use. Every picture is
+     *     released to the pipeline as soon as it is received: hierarchical_levels,
+     *     look_ahead_distance and scene_change_detection are forced to 0 and only
+     *     rate control modes 0 and 2 are supported.
+     * 2 = Random Access.
+     *
      * Default is 2. */
     uint8_t                  pred_structure;
     /* Decides whether to use B picture or P picture in the base layer.
@@ -246,6 +259,8 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * 0 = Constant QP.
      * 1 = Average BitRate.
+     * 2 = Constant BitRate, constrained by a VBV buffer model, for low latency
+     *     use with a small or zero look ahead distance.
      *
      * Default is 0. */
     uint32_t                 rate_control_mode;
@@ -275,6 +290,34 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 min_qp_allowed;
+    /* Size of the VBV (leaky bucket) buffer in milliseconds at the target
+     * bitrate, only applicable when rate control mode is set to 2.
+     *
+     * Default is 1000. */
+    uint32_t                 vbv_buffer_size_ms;
+    /* Initial fullness of the VBV buffer in milliseconds at the target bitrate,
+     * also the level the rate control steers towards. Only applicable when rate
+     * control mode is set to 2. It has to be smaller or equal to vbv_buffer_size_ms.
+     *
+     * Default is 600. */
+    uint32_t                 vbv_initial_level_ms;
+    /* Pass of a two pass encode.
+     *
+     * 0 = single pass.
+     * 1 = first pass: the sequence is encoded with the fastest preset at a
+     *     constant qp, without a look ahead, and per frame statistics are
+     *     collected, to be retrieved with eb_svt_enc_get_first_pass_stats.
+     *     Requires frames_to_be_encoded.
+     * 2 = second pass: the bits of the sequence are allocated from the
+     *     statistics in rc_stats_buffer. Requires rate control mode 1.
+     *
+     * Default is 0. */
+    uint32_t                 pass;
+    /* Statistics of the first pass, only applicable when pass is 2. The buffer
+     * is owned by the application and must stay valid until eb_deinit_encoder.
+     *
+     * Default is empty. */
+    EbSvtAv1FixedBuf         rc_stats_buffer;
 
     // Tresholds
     /* Flag to signal that the input yuv is HDR10 BT2020 using SMPTE ST2048, requires
@@ -315,7 +358,23 @@ typedef struct EbSvtAv1EncConfiguration
     /* ID assigned to each channel when multiple instances are running within the
      * same application. */
     uint32_t                 channel_id;
+    /* Number of channels running concurrently within the same application.
+     *
+     * Default is 1. */
     uint32_t                 active_channel_count;
+    /* Number of logical processors shared by all the encoders of the process
+     * that set a core budget. Each encoder keeps its own worker threads, but
+     * at most core_budget of the workers of these encoders process a task at
+     * a time: the other ones wait for a worker to finish its task or block.
+     * An idle channel so leaves its cores to the busy ones. Waiting workers
+     * are served in arrival order, not by channel deadline. The first encoder
+     * initialized with a core budget sets its size for the process, so the
+     * encoders sharing it are to be initialized one at a time.
+     *
+     * 0 = no core budget.
+     *
+     * Default is 0. */
+    uint32_t                 core_budget;
 
     /* Flag to enable the Speed Control functionality to achieve the real-time
     * encoding speed defined by dynamically changing the encoding preset to meet
@@ -337,16 +396,24 @@ typedef struct EbSvtAv1EncConfiguration
      * OS thread scheduler. */
     uint32_t                logical_processors;
 
-    /* Target socket to run on. For dual socket systems, this can specify which
-     * socket the encoder runs on.
+    /* Target socket to run on. For multi-socket systems, this can specify which
+     * socket the encoder runs on. On Linux the encoder memory is then also
+     * allocated on the NUMA node of that socket.
      *
-     * -1 = Both Sockets.
-     *  0 = Socket 0.
-     *  1 = Socket 1.
+     * -1 = All Sockets.
+     *  N = Socket N, in [0 - socket count - 1].
      *
      * Default is -1. */
     int32_t                 target_socket;
 
+    /* Construct the picture control set and reference picture pools on first
+     * use instead of at eb_init_encoder(). The pools grow up to the same size
+     * as with eager allocation, so steady state memory is unchanged, but the
+     * encoder starts faster and short clips never touch their full footprint.
+     *
+     * Default is 0. */
+    EbBool                  lazy_pool_allocation;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -354,6 +421,19 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 recon_enabled;
+
+    /* Hand out the reconstructed picture through eb_svt_get_recon_view() as a
+     * read-only view of the encoder picture instead of copying it into a
+     * frame-sized output buffer. Only applicable when recon_enabled is set.
+     * The viewed picture stays locked in the encoder until the view is
+     * released, so views should be returned promptly. A view of a picture not
+     * used as a reference, or of any picture when film grain is applied, also
+     * holds one of the few picture control sets the encoder codes with: one is
+     * reserved for it, so hold at most one such view at a time, or the encoder
+     * stalls until they are released.
+     *
+     * Default is 0. */
+    EbBool                   recon_zero_copy;
 #if TILES
     /* Log 2 Tile Rows and colums . 0 means no tiling,1 means that we split the dimension
         * into 2
@@ -449,6 +529,21 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbBufferHeaderType       **output_stream_ptr);
 
+    /* OPTIONAL: Update encoding parameters while encoding, without
+     * re-initializing the encoder. Only enc_mode, target_bit_rate and
+     * logical_processors are taken from the structure, all other fields are
+     * ignored. enc_mode and target_bit_rate apply from the first picture of
+     * the next mini-GOP; logical_processors re-pins the threads of this
+     * encoder immediately, as logical_processors does at initialization. The
+     * number of encoder threads does not change.
+     *
+     * Parameter:
+     * @ *svt_enc_component              Encoder handler.
+     * @ *pComponentParameterStructure  Structure holding the new values. */
+    EB_API EbErrorType eb_svt_enc_update_parameter(
+        EbComponentType           *svt_enc_component,
+        EbSvtAv1EncConfiguration   *pComponentParameterStructure);
+
     /* STEP 4: Send the picture.
      *
      * Parameter:
@@ -458,6 +553,21 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* STEP 4 (alternative): Send several pictures, in order.
+     * Same as calling eb_svt_enc_send_picture for each of them, but the input
+     * buffers available are reserved and queued to the encoder together, with
+     * one lock round-trip per group rather than per picture. Blocks while the
+     * input buffer pool is empty.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ **p_buffers         Array of count header pointers, picture buffers.
+     * @ count               Number of pictures. */
+    EB_API EbErrorType eb_svt_enc_send_pictures(
+        EbComponentType      *svt_enc_component,
+        EbBufferHeaderType  **p_buffers,
+        uint32_t              count);
+
     /* STEP 5: Receive packet.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
@@ -485,6 +595,81 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Get a read-only view of the next reconstructed picture, without
+     * copying it. Requires recon_enabled and recon_zero_copy.
+     *
+     * On success (*p_buffer)->p_buffer points to an EbSvtIOFormat holding the
+     * luma, cb and cr plane pointers of the visible area; strides, width and
+     * height are in samples, and samples are 16 bit when encoder_bit_depth > 8.
+     * flags and pts are set as for eb_svt_get_recon.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ **p_buffer          Header pointer to return the view with.
+     * Non-locking call, returns EB_NoErrorEmptyQueue when no picture is available. */
+    EB_API EbErrorType eb_svt_get_recon_view(
+        EbComponentType      *svt_enc_component,
+        EbBufferHeaderType  **p_buffer);
+
+    /* OPTIONAL: Release a view obtained with eb_svt_get_recon_view, unlocking the
+     * underlying picture. Must be called for every view before eb_deinit_encoder,
+     * see recon_zero_copy for how many views may be held at a time.
+     *
+     * Parameter:
+     * @ **p_buffer          Header pointer that contains the view to be released. */
+    EB_API void eb_svt_release_recon_view(
+        EbBufferHeaderType  **p_buffer);
+
+    /* Output kinds reported to the output notification callback. */
+#define EB_OUTPUT_PACKET    1
+#define EB_OUTPUT_RECON     2
+
+    typedef void (*EbOutputReadyCallback)(
+        void                 *app_data,
+        uint32_t              output_type);
+
+    /* OPTIONAL: Register a function called each time a packet (EB_OUTPUT_PACKET)
+     * or a reconstructed picture (EB_OUTPUT_RECON) becomes available, so that the
+     * application can wake its output thread instead of polling eb_svt_get_packet.
+     * The callback runs on an encoder thread: it must return quickly and must not
+     * call into the encoder. Call after eb_init_handle and before eb_init_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ callback            Function to call, NULL to unregister.
+     * @ *app_data           Passed back to the callback. */
+    EB_API EbErrorType eb_svt_enc_set_output_callback(
+        EbComponentType      *svt_enc_component,
+        EbOutputReadyCallback callback,
+        void                 *app_data);
+
+    /* OPTIONAL: Get a file descriptor that becomes readable when a packet or a
+     * reconstructed picture is available, for poll/epoll based applications.
+     * Reading 8 bytes from it clears it; the application then drains
+     * eb_svt_get_packet / eb_svt_get_recon until EB_NoErrorEmptyQueue. The
+     * descriptor is owned by the encoder and closed by eb_deinit_encoder.
+     * Call after eb_init_handle and before eb_init_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *fd                 Returns the descriptor.
+     * Returns EB_ErrorUndefined where eventfd is not available (Linux only). */
+    EB_API EbErrorType eb_svt_enc_get_output_event_fd(
+        EbComponentType      *svt_enc_component,
+        int32_t              *fd);
+
+    /* OPTIONAL: Get the statistics collected by a first pass encode (pass 1),
+     * to be passed as rc_stats_buffer of the second pass. Call after the EOS
+     * packet has been received; the buffer stays owned by the encoder and is
+     * valid until eb_deinit_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats              Returns the statistics buffer. */
+    EB_API EbErrorType eb_svt_enc_get_first_pass_stats(
+        EbComponentType      *svt_enc_component,
+        EbSvtAv1FixedBuf     *stats);
+
     /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -27,6 +27,8 @@
 #define OUTPUT_RECON_TOKEN              "-o"
 #define ERROR_FILE_TOKEN                "-errlog"
 #define QP_FILE_TOKEN                   "-qp-file"
+#define INPUT_STATS_FILE_TOKEN          "-stats-in"
+#define OUTPUT_STATS_FILE_TOKEN         "-stats-out"
 #define WIDTH_TOKEN                     "-w"
 #define HEIGHT_TOKEN                    "-h"
 #define NUMBER_OF_PICTURES_TOKEN        "-n"
@@ -80,6 +82,9 @@
 #define TARGET_BIT_RATE_TOKEN           "-tbr"
 #define MAX_QP_TOKEN                    "-max-qp"
 #define MIN_QP_TOKEN                    "-min-qp"
+#define VBV_BUFFER_SIZE_TOKEN           "-vbv-size"
+#define VBV_INITIAL_LEVEL_TOKEN         "-vbv-init"
+#define PASS_TOKEN                      "-pass"
 #define LOOK_AHEAD_DIST_TOKEN           "-lad"
 #define SUPER_BLOCK_SIZE_TOKEN          "-sb-size"
 #if TILES
@@ -93,6 +98,7 @@
 #define ASM_TYPE_TOKEN                  "-asm"
 #define THREAD_MGMNT                    "-lp"
 #define TARGET_SOCKET                   "-ss"
+#define CORE_BUDGET_TOKEN               "-core-budget"
 #define CONFIG_FILE_COMMENT_CHAR    '#'
 #define CONFIG_FILE_NEWLINE_CHAR    '\n'
 #define CONFIG_FILE_RETURN_CHAR     '\r'
@@ -154,6 +160,16 @@ static void SetCfgQpFile                        (const char *value, EbConfig_t *
     if (cfg->qpFile) { fclose(cfg->qpFile); }
     FOPEN(cfg->qpFile,value, "r");
 };
+static void SetCfgInputStatsFile                (const char *value, EbConfig_t *cfg)
+{
+    if (cfg->inputStatsFile) { fclose(cfg->inputStatsFile); }
+    FOPEN(cfg->inputStatsFile,value, "rb");
+};
+static void SetCfgOutputStatsFile               (const char *value, EbConfig_t *cfg)
+{
+    if (cfg->outputStatsFile) { fclose(cfg->outputStatsFile); }
+    FOPEN(cfg->outputStatsFile,value, "wb");
+};
 static void SetCfgSourceWidth                   (const char *value, EbConfig_t *cfg) {cfg->sourceWidth = strtoul(value, NULL, 0);};
 static void SetInterlacedVideo                  (const char *value, EbConfig_t *cfg) {cfg->interlacedVideo  = (EbBool) strtoul(value, NULL, 0);};
 static void SetSeperateFields                   (const char *value, EbConfig_t *cfg) {cfg->separateFields = (EbBool) strtoul(value, NULL, 0);};
@@ -196,6 +212,9 @@ static void SetRateControlMode                  (const char *value, EbConfig_t *
 static void SetTargetBitRate                    (const char *value, EbConfig_t *cfg) {cfg->targetBitRate = strtoul(value, NULL, 0);};
 static void SetMaxQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->max_qp_allowed = strtoul(value, NULL, 0);};
 static void SetMinQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->min_qp_allowed = strtoul(value, NULL, 0);};
+static void SetVbvBufferSize                    (const char *value, EbConfig_t *cfg) {cfg->vbv_buffer_size_ms = strtoul(value, NULL, 0);};
+static void SetVbvInitialLevel                  (const char *value, EbConfig_t *cfg) {cfg->vbv_initial_level_ms = strtoul(value, NULL, 0);};
+static void SetPass                             (const char *value, EbConfig_t *cfg) {cfg->pass = strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel1Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel1Flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel2Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel2Flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaWidth               (const char *value, EbConfig_t *cfg) {cfg->searchAreaWidth = strtoul(value, NULL, 0);};
@@ -239,6 +258,7 @@ static void SetLatencyMode                      (const char *value, EbConfig_t *
 static void SetAsmType                          (const char *value, EbConfig_t *cfg)  {cfg->asmType                   = (uint32_t)strtoul(value, NULL, 0);};
 static void SetLogicalProcessors                (const char *value, EbConfig_t *cfg)  {cfg->logicalProcessors         = (uint32_t)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig_t *cfg)  {cfg->targetSocket              = (int32_t)strtol(value, NULL, 0);};
+static void SetCoreBudget                       (const char *value, EbConfig_t *cfg)  {cfg->coreBudget                = (uint32_t)strtoul(value, NULL, 0);};
 
 enum cfg_type{
     SINGLE_INPUT,   // Configuration parameters that have only 1 value input
@@ -266,6 +286,8 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, ERROR_FILE_TOKEN, "ErrorFile", SetCfgErrorFile },
     { SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", SetCfgReconFile },
     { SINGLE_INPUT, QP_FILE_TOKEN, "QpFile", SetCfgQpFile },
+    { SINGLE_INPUT, INPUT_STATS_FILE_TOKEN, "InputStatsFile", SetCfgInputStatsFile },
+    { SINGLE_INPUT, OUTPUT_STATS_FILE_TOKEN, "OutputStatsFile", SetCfgOutputStatsFile },
 
     // Interlaced Video
     { SINGLE_INPUT, INTERLACED_VIDEO_TOKEN , "InterlacedVideo" , SetInterlacedVideo },
@@ -303,6 +325,9 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, TARGET_BIT_RATE_TOKEN, "TargetBitRate", SetTargetBitRate },
     { SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", SetMaxQpAllowed },
     { SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", SetMinQpAllowed },
+    { SINGLE_INPUT, VBV_BUFFER_SIZE_TOKEN, "VbvBufferSize", SetVbvBufferSize },
+    { SINGLE_INPUT, VBV_INITIAL_LEVEL_TOKEN, "VbvInitialLevel", SetVbvInitialLevel },
+    { SINGLE_INPUT, PASS_TOKEN, "Pass", SetPass },
 
     // DLF
     { SINGLE_INPUT, LOOP_FILTER_DISABLE_TOKEN, "LoopFilterDisable", SetDisableDlfFlag },
@@ -335,6 +360,7 @@ config_entry_t config_entry[] = {
     // Thread Management
     { SINGLE_INPUT, THREAD_MGMNT, "logicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, CORE_BUDGET_TOKEN, "CoreBudget", SetCoreBudget },
 
     // Optional Features
 
@@ -378,6 +404,8 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->reconFile                            = NULL;
     config_ptr->errorLogFile                         = stderr;
     config_ptr->qpFile                               = NULL;
+    config_ptr->inputStatsFile                       = NULL;
+    config_ptr->outputStatsFile                      = NULL;
 
 
     config_ptr->frameRate                            = 30 << 16;
@@ -399,6 +427,7 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->separateFields                       = EB_FALSE;
     config_ptr->qp                                   = 50;
     config_ptr->use_qp_file                          = EB_FALSE;
+    config_ptr->qpReadFromFile                       = EB_FALSE;
 
     config_ptr->scene_change_detection               = 0;
     config_ptr->rateControlMode                      = 0;
@@ -406,6 +435,9 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->targetBitRate                        = 7000000;
     config_ptr->max_qp_allowed                       = 63;
     config_ptr->min_qp_allowed                       = 0;
+    config_ptr->vbv_buffer_size_ms                   = 1000;
+    config_ptr->vbv_initial_level_ms                 = 600;
+    config_ptr->pass                                 = 0;
     config_ptr->base_layer_switch_mode               = 0;
     config_ptr->encMode                              = MAX_ENC_PRESET;
     config_ptr->intraPeriod                          = -2;
@@ -491,6 +523,7 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->stopEncoder                          = 0;
     config_ptr->logicalProcessors                    = 0;
     config_ptr->targetSocket                         = -1;
+    config_ptr->coreBudget                           = 0;
     config_ptr->processedFrameCount                  = 0;
     config_ptr->processedByteCount                   = 0;
 #if TILES
@@ -539,6 +572,16 @@ void EbConfigDtor(EbConfig_t *config_ptr)
         config_ptr->qpFile = (FILE *)NULL;
     }
 
+    if (config_ptr->inputStatsFile) {
+        fclose(config_ptr->inputStatsFile);
+        config_ptr->inputStatsFile = (FILE *)NULL;
+    }
+
+    if (config_ptr->outputStatsFile) {
+        fclose(config_ptr->outputStatsFile);
+        config_ptr->outputStatsFile = (FILE *)NULL;
+    }
+
     return;
 }
 
@@ -783,6 +826,16 @@ static EbErrorType VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->pass == 1 && config->outputStatsFile == NULL) {
+        fprintf(config->errorLogFile, "Error instance %u: The first pass requires an OutputStatsFile\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pass == 2 && config->inputStatsFile == NULL) {
+        fprintf(config->errorLogFile, "Error instance %u: Could not find the InputStatsFile of the second pass\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->separateFields > 1) {
         fprintf(config->errorLogFile, "Error Instance %u: Invalid SeperateFields Input\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -810,8 +863,9 @@ static EbErrorType VerifySettings(EbConfig_t *config, uint32_t channelNumber)
     }
 
     // TargetSocket
-    if (config->targetSocket != -1 && config->targetSocket != 0 && config->targetSocket != 1) {
-        fprintf(config->errorLogFile, "Error instance %u: Invalid TargetSocket [-1 - 1], your input: %d\n", channelNumber + 1, config->targetSocket);
+    // (the upper bound depends on the host and is checked by the library)
+    if (config->targetSocket < -1) {
+        fprintf(config->errorLogFile, "Error instance %u: Invalid TargetSocket [-1 - socket count - 1], your input: %d\n", channelNumber + 1, config->targetSocket);
         return_error = EB_ErrorBadParameter;
     }
 
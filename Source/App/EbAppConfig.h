@@ -160,7 +160,7 @@ extern rsize_t strnlen_ss(const char *s, rsize_t smax);
     printf("Total Number of Mallocs in App: %d\n", appMallocCount); \
     printf("Total App Memory: %.2lf KB\n\n",*totalAppMemory/(double)1024);
 
-#define MAX_CHANNEL_NUMBER      6
+#define MAX_CHANNEL_NUMBER      16
 #define MAX_NUM_TOKENS          200
 
 #ifdef _MSC_VER
@@ -216,11 +216,14 @@ typedef struct EbConfig_s
     FILE                    *bufferFile;
 
     FILE                    *qpFile;
+    FILE                    *inputStatsFile;
+    FILE                    *outputStatsFile;
 
     EbBool                  y4mInput;
     unsigned char           y4mBuf[9];
 
     EbBool                  use_qp_file;
+    EbBool                  qpReadFromFile;
 
     uint32_t                 frameRate;
     uint32_t                 frameRateNumerator;
@@ -335,6 +338,9 @@ typedef struct EbConfig_s
     uint32_t                 targetBitRate;
     uint32_t                 max_qp_allowed;
     uint32_t                 min_qp_allowed;
+    uint32_t                 vbv_buffer_size_ms;
+    uint32_t                 vbv_initial_level_ms;
+    uint32_t                 pass;
 
     /****************************************
      * Optional Features
@@ -372,6 +378,7 @@ typedef struct EbConfig_s
     uint32_t                active_channel_count;
     uint32_t                logicalProcessors;
     int32_t                 targetSocket;
+    uint32_t                coreBudget;
     EbBool                 stopEncoder;         // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t                processedFrameCount;
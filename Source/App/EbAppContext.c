@@ -185,6 +185,20 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.target_bit_rate = config->targetBitRate;
     callbackData->ebEncParameters.max_qp_allowed = config->max_qp_allowed;
     callbackData->ebEncParameters.min_qp_allowed = config->min_qp_allowed;
+    callbackData->ebEncParameters.vbv_buffer_size_ms = config->vbv_buffer_size_ms;
+    callbackData->ebEncParameters.vbv_initial_level_ms = config->vbv_initial_level_ms;
+    callbackData->ebEncParameters.pass = config->pass;
+    if (config->pass == 2 && config->inputStatsFile) {
+        // The statistics stay in the app memory table until the encoder is deinitialized
+        uint64_t statsSize;
+
+        fseeko64(config->inputStatsFile, 0, SEEK_END);
+        statsSize = ftello64(config->inputStatsFile);
+        fseeko64(config->inputStatsFile, 0, SEEK_SET);
+
+        EB_APP_MALLOC(void*, callbackData->ebEncParameters.rc_stats_buffer.buf, (size_t)statsSize, EB_N_PTR, EB_ErrorInsufficientResources);
+        callbackData->ebEncParameters.rc_stats_buffer.sz = fread(callbackData->ebEncParameters.rc_stats_buffer.buf, 1, (size_t)statsSize, config->inputStatsFile);
+    }
     callbackData->ebEncParameters.qp = config->qp;
     callbackData->ebEncParameters.use_qp_file = (EbBool)config->use_qp_file;
     callbackData->ebEncParameters.disable_dlf_flag = (EbBool)config->disable_dlf_flag;
@@ -215,6 +229,7 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.asm_type = config->asmType;
     callbackData->ebEncParameters.logical_processors = config->logicalProcessors;
     callbackData->ebEncParameters.target_socket = config->targetSocket;
+    callbackData->ebEncParameters.core_budget = config->coreBudget;
     callbackData->ebEncParameters.recon_enabled = config->reconFile ? EB_TRUE : EB_FALSE;
 
     for (hmeRegionIndex = 0; hmeRegionIndex < callbackData->ebEncParameters.number_hme_search_region_in_width; ++hmeRegionIndex) {
@@ -604,6 +619,18 @@ EbErrorType InitEncoder(
         return return_error;
     }
 
+    // Wake the channel output thread when an output is ready
+    if (callbackData->outputReadyCallback) {
+        return_error = eb_svt_enc_set_output_callback(
+                           callbackData->svtEncoderHandle,
+                           callbackData->outputReadyCallback,
+                           callbackData->outputReadyData);
+
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
     // STEP 5: Init Encoder
     return_error = eb_init_encoder(callbackData->svtEncoderHandle);
     if (return_error != EB_ErrorNone) { return return_error; }
@@ -30,6 +30,10 @@ typedef struct EbAppContext_s {
     EbBufferHeaderType                *streamBufferPool;
     EbBufferHeaderType                *recon_buffer;
 
+    // Output ready notification, registered by InitEncoder when not NULL
+    EbOutputReadyCallback               outputReadyCallback;
+    void                               *outputReadyData;
+
     // Instance Index
     uint8_t                            instanceIdx;
 
@@ -76,6 +76,190 @@ void AssignAppThreadGroup(uint8_t targetSocket) {
 #endif
 }
 
+/***************************************
+ * Channel Threads
+ *  Each channel runs one input thread (read + send)
+ *  and one output thread (receive + write). The
+ *  library buffer pools bound the queue in between.
+ ***************************************/
+#ifdef _WIN32
+typedef DWORD AppThreadReturn;
+#define APP_THREAD_CALL     WINAPI
+#define APP_THREAD_EXIT     0
+#else
+typedef void* AppThreadReturn;
+#define APP_THREAD_CALL
+#define APP_THREAD_EXIT     NULL
+#endif
+
+typedef struct EbAppChannel_s {
+    EbConfig_t             *config;
+    EbAppContext_t         *appCallBack;
+
+    APPEXITCONDITIONTYPE    exitConditionInput;
+    APPEXITCONDITIONTYPE    exitConditionRecon;
+    APPEXITCONDITIONTYPE    exitConditionOutput;
+
+    EbBool                  inputThreadStarted;
+#ifdef _WIN32
+    HANDLE                  inputThread;
+    HANDLE                  outputThread;
+    HANDLE                  outputReadySemaphore;
+#else
+    pthread_t               inputThread;
+    pthread_t               outputThread;
+    pthread_mutex_t         outputReadyMutex;
+    pthread_cond_t          outputReadyCond;
+    uint32_t                outputReadyCount;   // outputs notified and not waited for yet
+#endif
+} EbAppChannel_t;
+
+static void ChannelOutputReady(void *app_data, uint32_t output_type)
+{
+    EbAppChannel_t *channel = (EbAppChannel_t*)app_data;
+    (void)output_type;
+#ifdef _WIN32
+    ReleaseSemaphore(channel->outputReadySemaphore, 1, NULL);
+#else
+    pthread_mutex_lock(&channel->outputReadyMutex);
+    channel->outputReadyCount++;
+    pthread_cond_signal(&channel->outputReadyCond);
+    pthread_mutex_unlock(&channel->outputReadyMutex);
+#endif
+}
+
+static void ChannelWaitOutputReady(EbAppChannel_t *channel)
+{
+#ifdef _WIN32
+    WaitForSingleObject(channel->outputReadySemaphore, INFINITE);
+#else
+    pthread_mutex_lock(&channel->outputReadyMutex);
+    while (channel->outputReadyCount == 0)
+        pthread_cond_wait(&channel->outputReadyCond, &channel->outputReadyMutex);
+    channel->outputReadyCount--;
+    pthread_mutex_unlock(&channel->outputReadyMutex);
+#endif
+}
+
+static AppThreadReturn APP_THREAD_CALL ChannelInputKernel(void *input_ptr)
+{
+    EbAppChannel_t *channel = (EbAppChannel_t*)input_ptr;
+
+    // eb_svt_enc_send_picture blocks while the input buffer pool is empty
+    while (channel->exitConditionInput == APP_ExitConditionNone)
+        channel->exitConditionInput = ProcessInputBuffer(
+                                            channel->config,
+                                            channel->appCallBack);
+
+    return APP_THREAD_EXIT;
+}
+
+static AppThreadReturn APP_THREAD_CALL ChannelOutputKernel(void *input_ptr)
+{
+    EbAppChannel_t *channel = (EbAppChannel_t*)input_ptr;
+
+    if (channel->config->reconFile == NULL) {
+        // Packets only: block in the library until the next one
+        while (channel->exitConditionOutput == APP_ExitConditionNone)
+            channel->exitConditionOutput = ProcessOutputStreamBuffer(
+                                                channel->config,
+                                                channel->appCallBack,
+                                                1);
+    }
+    else {
+        // Packets and recon pictures: sleep until the library notifies one of them
+        while ((channel->exitConditionOutput == APP_ExitConditionNone || channel->exitConditionRecon == APP_ExitConditionNone) &&
+                channel->exitConditionOutput != APP_ExitConditionError && channel->exitConditionRecon != APP_ExitConditionError) {
+            ChannelWaitOutputReady(channel);
+            if (channel->exitConditionRecon == APP_ExitConditionNone)
+                channel->exitConditionRecon = ProcessOutputReconBuffer(
+                                                    channel->config,
+                                                    channel->appCallBack);
+            if (channel->exitConditionOutput == APP_ExitConditionNone)
+                channel->exitConditionOutput = ProcessOutputStreamBuffer(
+                                                    channel->config,
+                                                    channel->appCallBack,
+                                                    0);
+        }
+    }
+
+    return APP_THREAD_EXIT;
+}
+
+static EbBool ChannelCtor(EbAppChannel_t *channel, EbConfig_t *config, EbAppContext_t *appCallBack)
+{
+    channel->config                 = config;
+    channel->appCallBack            = appCallBack;
+    channel->exitConditionInput     = APP_ExitConditionNone;
+    channel->exitConditionRecon     = config->reconFile ? APP_ExitConditionNone : APP_ExitConditionError;
+    channel->exitConditionOutput    = APP_ExitConditionNone;
+
+    // Only the recon case waits on the notifications
+    appCallBack->outputReadyCallback = config->reconFile ? ChannelOutputReady : NULL;
+    appCallBack->outputReadyData     = channel;
+
+#ifdef _WIN32
+    channel->outputReadySemaphore = CreateSemaphore(NULL, 0, MAXLONG, NULL);
+    return (channel->outputReadySemaphore != NULL) ? EB_TRUE : EB_FALSE;
+#else
+    channel->outputReadyCount = 0;
+    if (pthread_mutex_init(&channel->outputReadyMutex, NULL) != 0)
+        return EB_FALSE;
+    if (pthread_cond_init(&channel->outputReadyCond, NULL) != 0) {
+        pthread_mutex_destroy(&channel->outputReadyMutex);
+        return EB_FALSE;
+    }
+    return EB_TRUE;
+#endif
+}
+
+static void ChannelDtor(EbAppChannel_t *channel)
+{
+#ifdef _WIN32
+    CloseHandle(channel->outputReadySemaphore);
+#else
+    pthread_cond_destroy(&channel->outputReadyCond);
+    pthread_mutex_destroy(&channel->outputReadyMutex);
+#endif
+}
+
+static EbBool ChannelStart(EbAppChannel_t *channel)
+{
+    // The output thread starts first: once it runs, the input side can always complete
+#ifdef _WIN32
+    channel->outputThread = CreateThread(NULL, 0, ChannelOutputKernel, channel, 0, NULL);
+    if (channel->outputThread == NULL)
+        return EB_FALSE;
+    channel->inputThread = CreateThread(NULL, 0, ChannelInputKernel, channel, 0, NULL);
+    channel->inputThreadStarted = (channel->inputThread != NULL) ? EB_TRUE : EB_FALSE;
+#else
+    if (pthread_create(&channel->outputThread, NULL, ChannelOutputKernel, channel) != 0)
+        return EB_FALSE;
+    channel->inputThreadStarted = (pthread_create(&channel->inputThread, NULL, ChannelInputKernel, channel) == 0) ? EB_TRUE : EB_FALSE;
+#endif
+    // Fall back to sending the pictures from the calling thread
+    if (channel->inputThreadStarted == EB_FALSE)
+        ChannelInputKernel(channel);
+
+    return EB_TRUE;
+}
+
+static void ChannelJoin(EbAppChannel_t *channel)
+{
+#ifdef _WIN32
+    if (channel->inputThreadStarted) {
+        WaitForSingleObject(channel->inputThread, INFINITE);
+        CloseHandle(channel->inputThread);
+    }
+    WaitForSingleObject(channel->outputThread, INFINITE);
+    CloseHandle(channel->outputThread);
+#else
+    if (channel->inputThreadStarted)
+        pthread_join(channel->inputThread, NULL);
+    pthread_join(channel->outputThread, NULL);
+#endif
+}
+
 /***************************************
  * Encoder App Main
  ***************************************/
@@ -87,15 +271,12 @@ int32_t main(int32_t argc, char* argv[])
 #endif
     // GLOBAL VARIABLES
     EbErrorType            return_error = EB_ErrorNone;            // Error Handling
-    APPEXITCONDITIONTYPE    exitCondition = APP_ExitConditionNone;    // Processing loop exit condition
 
     EbErrorType            return_errors[MAX_CHANNEL_NUMBER];          // Error Handling
     APPEXITCONDITIONTYPE    exitConditions[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsOutput[MAX_CHANNEL_NUMBER];         // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsRecon[MAX_CHANNEL_NUMBER];         // Processing loop exit condition
-    APPEXITCONDITIONTYPE    exitConditionsInput[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
-
 
+    EbAppChannel_t          channels[MAX_CHANNEL_NUMBER];               // Channel threads
+    EbBool                 channelCreated[MAX_CHANNEL_NUMBER];
     EbBool                 channelActive[MAX_CHANNEL_NUMBER];
 
     EbConfig_t             *configs[MAX_CHANNEL_NUMBER];        // Encoder Configuration
@@ -132,9 +313,7 @@ int32_t main(int32_t argc, char* argv[])
 
         for (instanceCount = 0; instanceCount < MAX_CHANNEL_NUMBER; ++instanceCount) {
             exitConditions[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-            exitConditionsOutput[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-            exitConditionsRecon[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
-            exitConditionsInput[instanceCount] = APP_ExitConditionError;         // Processing loop exit condition
+            channelCreated[instanceCount] = EB_FALSE;
             channelActive[instanceCount] = EB_FALSE;
         }
 
@@ -158,7 +337,10 @@ int32_t main(int32_t argc, char* argv[])
 
                     EbStartTime((uint64_t*)&configs[instanceCount]->performanceContext.lib_start_time[0], (uint64_t*)&configs[instanceCount]->performanceContext.lib_start_time[1]);
 
-                    return_errors[instanceCount] = InitEncoder(configs[instanceCount], appCallbacks[instanceCount], instanceCount);
+                    channelCreated[instanceCount] = ChannelCtor(&channels[instanceCount], configs[instanceCount], appCallbacks[instanceCount]);
+                    return_errors[instanceCount] = channelCreated[instanceCount] ?
+                        InitEncoder(configs[instanceCount], appCallbacks[instanceCount], instanceCount) :
+                        EB_ErrorInsufficientResources;
                     return_error = (EbErrorType)(return_error | return_errors[instanceCount]);
                 }
                 else {
@@ -167,63 +349,35 @@ int32_t main(int32_t argc, char* argv[])
             }
 
             {
-                // Start the Encoder
+                printf("Encoding          ");
+                fflush(stdout);
+
+                // Start the Encoder: every channel runs on its own input and output threads
                 for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
                     if (return_errors[instanceCount] == EB_ErrorNone) {
                         return_error = (EbErrorType)(return_error & return_errors[instanceCount]);
-                        exitConditions[instanceCount]       = APP_ExitConditionNone;
-                        exitConditionsOutput[instanceCount] = APP_ExitConditionNone;
-                        exitConditionsRecon[instanceCount]  = configs[instanceCount]->reconFile ? APP_ExitConditionNone : APP_ExitConditionError;
-                        exitConditionsInput[instanceCount]  = APP_ExitConditionNone;
-                        channelActive[instanceCount]        = EB_TRUE;
                         EbStartTime((uint64_t*)&configs[instanceCount]->performanceContext.encode_start_time[0], (uint64_t*)&configs[instanceCount]->performanceContext.encode_start_time[1]);
 
-                    }
-                    else {
-                        exitConditions[instanceCount]       = APP_ExitConditionError;
-                        exitConditionsOutput[instanceCount] = APP_ExitConditionError;
-                        exitConditionsRecon[instanceCount]  = APP_ExitConditionError;
-                        exitConditionsInput[instanceCount]  = APP_ExitConditionError;
+                        // A channel that cannot start keeps its error exit condition
+                        channelActive[instanceCount] = ChannelStart(&channels[instanceCount]);
                     }
 
 #if DISPLAY_MEMORY
                     EB_APP_MEMORY();
 #endif
                 }
-                printf("Encoding          ");
-                fflush(stdout);
 
-                while (exitCondition == APP_ExitConditionNone) {
-                    exitCondition = APP_ExitConditionFinished;
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE) {
-                            if (exitConditionsInput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsInput[instanceCount] = ProcessInputBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsRecon[instanceCount] = ProcessOutputReconBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsOutput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsOutput[instanceCount] = ProcessOutputStreamBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount],
-                                                                            (exitConditionsInput[instanceCount] == APP_ExitConditionNone) || (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)? 0 : 1);
-                            if (((exitConditionsRecon[instanceCount] == APP_ExitConditionFinished || !configs[instanceCount]->reconFile)  && exitConditionsOutput[instanceCount] == APP_ExitConditionFinished && exitConditionsInput[instanceCount] == APP_ExitConditionFinished)||
-                                ((exitConditionsRecon[instanceCount] == APP_ExitConditionError && configs[instanceCount]->reconFile) || exitConditionsOutput[instanceCount] == APP_ExitConditionError || exitConditionsInput[instanceCount] == APP_ExitConditionError)){
-                                channelActive[instanceCount] = EB_FALSE;
-                                if (configs[instanceCount]->reconFile)
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                                else
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                            }
-                        }
-                    }
-                    // check if all channels are inactive
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE)
-                            exitCondition = APP_ExitConditionNone;
+                // Wait for the end of every channel
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    if (channelActive[instanceCount] == EB_TRUE) {
+                        EbAppChannel_t *channel = &channels[instanceCount];
+
+                        ChannelJoin(channel);
+                        channelActive[instanceCount] = EB_FALSE;
+                        if (configs[instanceCount]->reconFile)
+                            exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(channel->exitConditionRecon | channel->exitConditionOutput | channel->exitConditionInput);
+                        else
+                            exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(channel->exitConditionOutput | channel->exitConditionInput);
                     }
                 }
 
@@ -268,6 +422,12 @@ int32_t main(int32_t argc, char* argv[])
                 if (exitConditions[instanceCount] == APP_ExitConditionFinished && return_errors[instanceCount] == EB_ErrorNone) {
 
                     if (configs[instanceCount]->stopEncoder == EB_FALSE) {
+                        // First pass statistics
+                        if (configs[instanceCount]->pass == 1) {
+                            EbSvtAv1FixedBuf firstPassStats;
+                            if (eb_svt_enc_get_first_pass_stats(appCallbacks[instanceCount]->svtEncoderHandle, &firstPassStats) == EB_ErrorNone)
+                                fwrite(firstPassStats.buf, 1, (size_t)firstPassStats.sz, configs[instanceCount]->outputStatsFile);
+                        }
                         // Interlaced Video
                         if (configs[instanceCount]->interlacedVideo || configs[instanceCount]->separateFields) {
 
@@ -301,10 +461,26 @@ int32_t main(int32_t argc, char* argv[])
                     printf("Error encoding at channel %u! Check error log file for more details ... \n", instanceCount + 1);
                 }
             }
+            // Aggregate speed, to measure the scaling over the channels
+            if (numChannels > 1) {
+                uint64_t totalFrameCount = 0;
+                double   maxEncodeTime = 0;
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    if (exitConditions[instanceCount] == APP_ExitConditionFinished && return_errors[instanceCount] == EB_ErrorNone) {
+                        totalFrameCount += configs[instanceCount]->performanceContext.frameCount;
+                        if (configs[instanceCount]->performanceContext.total_encode_time > maxEncodeTime)
+                            maxEncodeTime = configs[instanceCount]->performanceContext.total_encode_time;
+                    }
+                }
+                if (maxEncodeTime > 0)
+                    printf("\nAll Channels\nAggregate Speed:\t%.3f fps\n", (double)totalFrameCount / maxEncodeTime);
+            }
             // DeInit Encoder
             for (instanceCount = numChannels; instanceCount > 0; --instanceCount) {
                 if (return_errors[instanceCount - 1] == EB_ErrorNone)
                     return_errors[instanceCount - 1] = DeInitEncoder(appCallbacks[instanceCount - 1], instanceCount - 1);
+                if (channelCreated[instanceCount - 1])
+                    ChannelDtor(&channels[instanceCount - 1]);
             }
         }
         else {
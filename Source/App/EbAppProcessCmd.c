@@ -693,16 +693,14 @@ void ProcessInputFieldStandardMode(
 // Input  : QP file
 // Output : QP value
 /************************************/
-static int32_t qpReadFromFile = 0;
-
 int32_t GetNextQpFromQpFile(
     EbConfig_t  *config
 )
 {
-    uint8_t *line;
+    // Called from the channel input thread: no allocation in the shared App memory table
+    uint8_t line[8];
     int32_t qp = 0;
     uint32_t readsize = 0, eof = 0;
-    EB_APP_MALLOC(uint8_t*, line, 8, EB_N_PTR, EB_ErrorInsufficientResources);
     memset(line,0,8);
     readsize = (uint32_t)fread(line, 1, 2, config->qpFile);
 
@@ -750,7 +748,7 @@ int32_t GetNextQpFromQpFile(
     }
 
     if (qp > 0)
-        qpReadFromFile |= 1;
+        config->qpReadFromFile = EB_TRUE;
 
     return qp;
 }
@@ -1150,14 +1148,14 @@ void SendQpOnTheFly(
             }
 
             // check if eof
-            if ((tmpQp == -1) && (qpReadFromFile != 0))
+            if ((tmpQp == -1) && (config->qpReadFromFile != EB_FALSE))
                 fseek(config->qpFile, 0, SEEK_SET);
 
             // check if the qp read is valid
             else if (tmpQp > 0)
                 break;
 
-        } while (tmpQp == 0 || ((tmpQp == -1) && (qpReadFromFile != 0)));
+        } while (tmpQp == 0 || ((tmpQp == -1) && (config->qpReadFromFile != EB_FALSE)));
 
         if (tmpQp == -1) {
             config->use_qp_file = EB_FALSE;
@@ -1363,9 +1361,6 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     uint64_t               *totalLatency     = &config->performanceContext.totalLatency;
     uint32_t               *maxLatency       = &config->performanceContext.maxLatency;
 
-    // System performance variables
-    static int32_t         frameCount                = 0;
-
     // Local variables
     uint64_t                finishsTime     = 0;
     uint64_t                finishuTime     = 0;
@@ -1479,25 +1474,23 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
         // Release the output buffer
         eb_svt_release_out_buffer(&headerPtr);
 
-#if DEADLOCK_DEBUG
-        ++frameCount;
-#else
-        //++frameCount;
-        printf("\b\b\b\b\b\b\b\b\b%9d", ++frameCount);
+#if !DEADLOCK_DEBUG
+        // Channels run on their own threads: only the first one draws the progress
+        if (config->channel_id == 0) {
+            printf("\b\b\b\b\b\b\b\b\b%9d", (int32_t)config->performanceContext.frameCount);
+            fflush(stdout);
+        }
 #endif
 
-        //++frameCount;
-        fflush(stdout);
-
         {
             config->performanceContext.averageSpeed = (config->performanceContext.frameCount) / config->performanceContext.total_encode_time;
             config->performanceContext.averageLatency = config->performanceContext.totalLatency / (double)(config->performanceContext.frameCount);
         }
 
-        if (!(frameCount % SPEED_MEASUREMENT_INTERVAL)) {
+        if (!(config->performanceContext.frameCount % SPEED_MEASUREMENT_INTERVAL)) {
             {
                 printf("\n");
-                printf("Average System Encoding Speed:        %.2f\n", (double)(frameCount) / config->performanceContext.total_encode_time);
+                printf("Channel %u Average System Encoding Speed:        %.2f\n", config->channel_id + 1, (double)(config->performanceContext.frameCount) / config->performanceContext.total_encode_time);
             }
         }
     }
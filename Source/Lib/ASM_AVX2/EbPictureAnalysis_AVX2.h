@@ -0,0 +1,54 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPictureAnalysis_AVX2_h
+#define EbPictureAnalysis_AVX2_h
+
+#include "EbDefinitions.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*******************************************
+    * decimation_2d_fused_avx2_intrin
+    *  1/4 and 1/16 decimation of the input in one read of the input rows.
+    *  A NULL output is skipped.
+    *******************************************/
+    void decimation_2d_fused_avx2_intrin(
+        uint8_t  *input_samples,
+        uint32_t  input_stride,
+        uint32_t  input_area_width,
+        uint32_t  input_area_height,
+        uint8_t  *quarter_samples,
+        uint32_t  quarter_stride,
+        uint8_t  *sixteenth_samples,
+        uint32_t  sixteenth_stride);
+
+    /*******************************************
+    * calculate_histogram_avx2_intrin
+    *  n-bins histogram and sum of the (decimated) input
+    *******************************************/
+    void calculate_histogram_avx2_intrin(
+        uint8_t  *input_samples,
+        uint32_t  input_area_width,
+        uint32_t  input_area_height,
+        uint32_t  stride,
+        uint8_t   decim_step,
+        uint32_t *histogram,
+        uint64_t *sum);
+
+    /*******************************************
+    * compute_histogram_abs_diff_avx2_intrin
+    *  sum of the absolute differences between the bins of two histograms
+    *******************************************/
+    uint32_t compute_histogram_abs_diff_avx2_intrin(
+        uint32_t *histogram_a,
+        uint32_t *histogram_b,
+        uint32_t  bin_count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPictureAnalysis_AVX2_h
@@ -0,0 +1,159 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+
+#include "EbPictureAnalysis_AVX2.h"
+#include "EbDefinitions.h"
+#include "immintrin.h"
+
+#define HISTOGRAM_BIN_COUNT 256
+
+void decimation_2d_fused_avx2_intrin(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride)
+{
+    const __m256i mask_16 = _mm256_set1_epi16(0x00FF);
+    const __m256i mask_32 = _mm256_set1_epi32(0x000000FF);
+    uint32_t vertical_index;
+    uint32_t horizontal_index;
+
+    for (vertical_index = 0; vertical_index < input_area_height; vertical_index += 2) {
+        // Every 4th row also feeds the 1/16 picture
+        uint8_t *sixteenth_row = (sixteenth_samples && !(vertical_index & 3)) ? sixteenth_samples + (vertical_index >> 2) * sixteenth_stride : NULL;
+
+        for (horizontal_index = 0; horizontal_index + 64 <= input_area_width; horizontal_index += 64) {
+            __m256i in0 = _mm256_loadu_si256((__m256i*)(input_samples + horizontal_index));
+            __m256i in1 = _mm256_loadu_si256((__m256i*)(input_samples + horizontal_index + 32));
+
+            if (quarter_samples) {
+                __m256i quarter = _mm256_packus_epi16(_mm256_and_si256(in0, mask_16), _mm256_and_si256(in1, mask_16));
+                _mm256_storeu_si256((__m256i*)(quarter_samples + (horizontal_index >> 1)), _mm256_permute4x64_epi64(quarter, 0xD8));
+            }
+            if (sixteenth_row) {
+                __m256i sixteenth = _mm256_packus_epi32(_mm256_and_si256(in0, mask_32), _mm256_and_si256(in1, mask_32));
+                sixteenth = _mm256_permute4x64_epi64(sixteenth, 0xD8);
+                sixteenth = _mm256_permute4x64_epi64(_mm256_packus_epi16(sixteenth, sixteenth), 0xD8);
+                _mm_storeu_si128((__m128i*)(sixteenth_row + (horizontal_index >> 2)), _mm256_castsi256_si128(sixteenth));
+            }
+        }
+        for (; horizontal_index < input_area_width; horizontal_index += 2) {
+            if (quarter_samples)
+                quarter_samples[horizontal_index >> 1] = input_samples[horizontal_index];
+            if (sixteenth_row && !(horizontal_index & 3))
+                sixteenth_row[horizontal_index >> 2] = input_samples[horizontal_index];
+        }
+
+        input_samples += input_stride << 1;
+        if (quarter_samples)
+            quarter_samples += quarter_stride;
+    }
+}
+
+void calculate_histogram_avx2_intrin(
+    uint8_t  *input_samples,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint32_t  stride,
+    uint8_t   decim_step,
+    uint32_t *histogram,
+    uint64_t *sum)
+{
+    // Interleaved sub-histograms break the dependency between the updates of
+    // consecutive samples of the same value
+    EB_ALIGN(32) uint32_t sub_histogram[4][HISTOGRAM_BIN_COUNT];
+    EB_ALIGN(32) uint8_t  samples[32];
+    const __m256i mask_32 = _mm256_set1_epi32(0x000000FF);
+    __m256i sum_256 = _mm256_setzero_si256();
+    uint64_t scalar_sum = 0;
+    uint32_t vertical_index;
+    uint32_t horizontal_index;
+    uint32_t bin;
+    uint32_t i;
+
+    memset(sub_histogram, 0, sizeof(sub_histogram));
+
+    for (vertical_index = 0; vertical_index < input_area_height; vertical_index += decim_step) {
+        horizontal_index = 0;
+        if (decim_step == 1) {
+            for (; horizontal_index + 32 <= input_area_width; horizontal_index += 32) {
+                __m256i in = _mm256_loadu_si256((__m256i*)(input_samples + horizontal_index));
+                sum_256 = _mm256_add_epi64(sum_256, _mm256_sad_epu8(in, _mm256_setzero_si256()));
+                _mm256_store_si256((__m256i*)samples, in);
+                for (i = 0; i < 32; i += 4) {
+                    ++sub_histogram[0][samples[i + 0]];
+                    ++sub_histogram[1][samples[i + 1]];
+                    ++sub_histogram[2][samples[i + 2]];
+                    ++sub_histogram[3][samples[i + 3]];
+                }
+            }
+        }
+        else if (decim_step == 4) {
+            for (; horizontal_index + 32 <= input_area_width; horizontal_index += 32) {
+                __m256i in = _mm256_and_si256(_mm256_loadu_si256((__m256i*)(input_samples + horizontal_index)), mask_32);
+                sum_256 = _mm256_add_epi64(sum_256, _mm256_sad_epu8(in, _mm256_setzero_si256()));
+                _mm256_store_si256((__m256i*)samples, in);
+                for (i = 0; i < 32; i += 8) {
+                    ++sub_histogram[0][samples[i + 0]];
+                    ++sub_histogram[1][samples[i + 4]];
+                }
+            }
+        }
+        for (; horizontal_index < input_area_width; horizontal_index += decim_step) {
+            ++sub_histogram[2][input_samples[horizontal_index]];
+            scalar_sum += input_samples[horizontal_index];
+        }
+        input_samples += (stride << (decim_step >> 1));
+    }
+
+    for (bin = 0; bin < HISTOGRAM_BIN_COUNT; bin += 8) {
+        __m256i bins = _mm256_loadu_si256((__m256i*)(histogram + bin));
+        bins = _mm256_add_epi32(bins, _mm256_add_epi32(
+            _mm256_add_epi32(_mm256_load_si256((__m256i*)(sub_histogram[0] + bin)), _mm256_load_si256((__m256i*)(sub_histogram[1] + bin))),
+            _mm256_add_epi32(_mm256_load_si256((__m256i*)(sub_histogram[2] + bin)), _mm256_load_si256((__m256i*)(sub_histogram[3] + bin)))));
+        _mm256_storeu_si256((__m256i*)(histogram + bin), bins);
+    }
+
+    {
+        uint64_t vector_sum;
+        __m128i sum_128 = _mm_add_epi64(_mm256_castsi256_si128(sum_256), _mm256_extracti128_si256(sum_256, 1));
+        sum_128 = _mm_add_epi64(sum_128, _mm_srli_si128(sum_128, 8));
+        _mm_storel_epi64((__m128i*)&vector_sum, sum_128);
+        *sum = scalar_sum + vector_sum;
+    }
+}
+
+uint32_t compute_histogram_abs_diff_avx2_intrin(
+    uint32_t *histogram_a,
+    uint32_t *histogram_b,
+    uint32_t  bin_count)
+{
+    __m256i  abs_diff_256 = _mm256_setzero_si256();
+    __m128i  abs_diff_128;
+    uint32_t abs_diff = 0;
+    uint32_t bin;
+
+    for (bin = 0; bin + 8 <= bin_count; bin += 8) {
+        __m256i a = _mm256_loadu_si256((__m256i*)(histogram_a + bin));
+        __m256i b = _mm256_loadu_si256((__m256i*)(histogram_b + bin));
+        abs_diff_256 = _mm256_add_epi32(abs_diff_256, _mm256_abs_epi32(_mm256_sub_epi32(a, b)));
+    }
+    for (; bin < bin_count; ++bin) {
+        int32_t diff = (int32_t)histogram_a[bin] - (int32_t)histogram_b[bin];
+        abs_diff += (uint32_t)(diff < 0 ? -diff : diff);
+    }
+
+    abs_diff_128 = _mm_add_epi32(_mm256_castsi256_si128(abs_diff_256), _mm256_extracti128_si256(abs_diff_256, 1));
+    abs_diff_128 = _mm_add_epi32(abs_diff_128, _mm_srli_si128(abs_diff_128, 8));
+    abs_diff_128 = _mm_add_epi32(abs_diff_128, _mm_srli_si128(abs_diff_128, 4));
+
+    return abs_diff + (uint32_t)_mm_cvtsi128_si32(abs_diff_128);
+}
@@ -40,6 +40,7 @@ extern void av1_predict_intra_block(
     ModeDecisionContext_t                  *md_context_ptr,
 #endif
     STAGE                       stage,
+    IntraEdgeCache_t           *edge_cache,
     uint8_t                     intra_luma_left_mode,
     uint8_t                     intra_luma_top_mode,
     uint8_t                     intra_chroma_left_mode,
@@ -2980,7 +2981,29 @@ EB_EXTERN void AV1EncodePass(
 
         //SB128_TODO change 10bit SB creation
 
-        if ((sequence_control_set_ptr->static_config.ten_bit_format == 1) || (sequence_control_set_ptr->static_config.compressed_ten_bit_format == 1))
+        if (inputPicture->buffer_16bit_y)
+        {
+            // Native 16bit input: plain copy of the SB, no repacking
+            const uint32_t inputLumaOffset = ((sb_origin_y + inputPicture->origin_y)         * inputPicture->stride_y) + (sb_origin_x + inputPicture->origin_x);
+            const uint32_t inputCbOffset = (((sb_origin_y + inputPicture->origin_y) >> 1)  * inputPicture->strideCb) + ((sb_origin_x + inputPicture->origin_x) >> 1);
+            const uint32_t inputCrOffset = (((sb_origin_y + inputPicture->origin_y) >> 1)  * inputPicture->strideCr) + ((sb_origin_x + inputPicture->origin_x) >> 1);
+            uint32_t rowIt;
+
+            for (rowIt = 0; rowIt < sb_height; rowIt++)
+                EB_MEMCPY((uint16_t *)context_ptr->input_sample16bit_buffer->buffer_y + rowIt * context_ptr->input_sample16bit_buffer->stride_y,
+                    inputPicture->buffer_16bit_y + inputLumaOffset + rowIt * inputPicture->stride_y,
+                    sb_width * sizeof(uint16_t));
+
+            for (rowIt = 0; rowIt < (sb_height >> 1); rowIt++) {
+                EB_MEMCPY((uint16_t *)context_ptr->input_sample16bit_buffer->bufferCb + rowIt * context_ptr->input_sample16bit_buffer->strideCb,
+                    inputPicture->buffer_16bit_cb + inputCbOffset + rowIt * inputPicture->strideCb,
+                    (sb_width >> 1) * sizeof(uint16_t));
+                EB_MEMCPY((uint16_t *)context_ptr->input_sample16bit_buffer->bufferCr + rowIt * context_ptr->input_sample16bit_buffer->strideCr,
+                    inputPicture->buffer_16bit_cr + inputCrOffset + rowIt * inputPicture->strideCr,
+                    (sb_width >> 1) * sizeof(uint16_t));
+            }
+        }
+        else if ((sequence_control_set_ptr->static_config.ten_bit_format == 1) || (sequence_control_set_ptr->static_config.compressed_ten_bit_format == 1))
         {
 
             const uint32_t inputLumaOffset = ((sb_origin_y + inputPicture->origin_y)         * inputPicture->stride_y) + (sb_origin_x + inputPicture->origin_x);
@@ -3395,6 +3418,7 @@ EB_EXTERN void AV1EncodePass(
                                         NULL,
 #endif
                                         ED_STAGE,
+                                        NULL,
                                         cu_ptr->prediction_unit_array[0].intra_luma_left_mode,
                                         cu_ptr->prediction_unit_array[0].intra_luma_top_mode,
                                         cu_ptr->prediction_unit_array[0].intra_chroma_left_mode,
@@ -106,9 +106,13 @@ extern "C" {
 #define DIS_EDGE_FIL                                    0 // disable intra edge filter - to be removed after fixing the neigbor array for intra 4xN and Nx4
 #define DISABLE_INTRA_PRED_INTRINSIC                    0 // To be used to switch between intrinsic and C code for intra-pred
 #define USE_INLOOP_ME_FULL_SAD                          0 // To switch between full SAD and subsampled-SAD for in-loop-me subpel.
+#define ADAPTIVE_ME_SEARCH_AREA                         1 // ME search areas sized from the HME level 0 spread
+#define OIS_MD_INTRA_PRUNING                            1 // MD skips the directional intra candidates far from the best open loop intra search direction
+#define ME_REFERENCE_PRUNING                            1 // ME drops the references of an SB with a poor HME level 0 SAD before the full-pel search, MD skips them too
 #define NO_SUBPEL_FOR_128X128                           1 // Intrinsic is not available for 128x128 Subpel
 //FOR DEBUGGING - Do not remove
 #define NO_ENCDEC                                       0 // bypass encDec to test cmpliance of MD. complained achieved when skip_flag is OFF. Port sample code from VCI-SW_AV1_Candidate1 branch
+#define MD_PROFILER                                     0 // rdtsc cycle counters around the MD kernels, per block size and preset, dumped at eb_deinit_encoder
 
 #define FIX_DEBUG_CRASH                                 1
 #define FIX_47                                          1 // interdepth decision to be tedted block aware
@@ -2176,7 +2180,8 @@ typedef enum EbPtrType {
     EB_A_PTR = 1,                                   // malloc'd pointer aligned
     EB_MUTEX = 2,                                   // mutex
     EB_SEMAPHORE = 3,                                   // semaphore
-    EB_THREAD = 4                                    // thread handle
+    EB_THREAD = 4,                                   // thread handle
+    EB_LAZY_OBJECTS = 5                             // allocation list of the objects a SystemResource constructed on demand
 } EbPtrType;
 
 typedef struct EbMemoryMapEntry
@@ -2208,6 +2213,24 @@ extern    EbMemoryMapEntry        *memory_map;               // library Memory t
 extern    uint32_t                  *memory_map_index;          // library memory index
 extern    uint64_t                  *total_lib_memory;          // library Memory malloc'd
 
+#ifdef _MSC_VER
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+// Allocation list of the SystemResource constructing an object on demand on
+// this thread, EB_NULL otherwise (see EbSystemResourceGrow)
+extern EB_THREAD_LOCAL EbMemoryMapEntry *lazy_memory_map;
+extern EB_THREAD_LOCAL uint32_t         *lazy_memory_map_index;
+extern EB_THREAD_LOCAL uint32_t          lazy_memory_map_size;
+extern EB_THREAD_LOCAL uint64_t         *lazy_total_lib_memory;
+
+#define EB_MEMORY_MAP           (lazy_memory_map ? lazy_memory_map : memory_map)
+#define EB_MEMORY_MAP_INDEX     (lazy_memory_map ? lazy_memory_map_index : memory_map_index)
+#define EB_MEMORY_MAP_SIZE      (lazy_memory_map ? lazy_memory_map_size : MAX_NUM_PTR)
+#define EB_TOTAL_LIB_MEMORY     (lazy_memory_map ? lazy_total_lib_memory : total_lib_memory)
+
 extern    uint32_t                   libMallocCount;
 extern    uint32_t                   lib_thread_count;
 extern    uint32_t                   libSemaphoreCount;
@@ -2269,16 +2292,16 @@ if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
     } \
     else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        *EB_TOTAL_LIB_MEMORY += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
 } \
 libMallocCount++;
@@ -2290,16 +2313,16 @@ if (posix_memalign((void**)(&(pointer)), ALVALUE, n_elements) != 0) { \
         } \
             else { \
     pointer = (type) pointer;  \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        *EB_TOTAL_LIB_MEMORY += (n_elements); \
             } \
             else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
     } \
 libMallocCount++;
@@ -2312,16 +2335,16 @@ if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
     } \
     else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        *EB_TOTAL_LIB_MEMORY += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
 } \
 libMallocCount++;
@@ -2332,16 +2355,16 @@ if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (count % 8 == 0) { \
-        *total_lib_memory += (count); \
+        *EB_TOTAL_LIB_MEMORY += (count); \
     } \
     else { \
-        *total_lib_memory += ((count) + (8 - ((count) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((count) + (8 - ((count) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
 } \
 libMallocCount++;
@@ -2352,16 +2375,16 @@ if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        *EB_TOTAL_LIB_MEMORY += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
 } \
 libSemaphoreCount++;
@@ -2372,16 +2395,16 @@ if (pointer == (type)EB_NULL){ \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    EB_MEMORY_MAP[*(EB_MEMORY_MAP_INDEX)].ptrType = pointer_class; \
+    EB_MEMORY_MAP[(*(EB_MEMORY_MAP_INDEX))++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        *EB_TOTAL_LIB_MEMORY += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        *EB_TOTAL_LIB_MEMORY += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+if (*(EB_MEMORY_MAP_INDEX) >= EB_MEMORY_MAP_SIZE) { \
     return EB_ErrorInsufficientResources; \
 } \
 libMutexCount++;
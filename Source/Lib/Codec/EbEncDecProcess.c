@@ -630,6 +630,7 @@ void ReconOutput(
 static void ReconOutput(
 #endif
     PictureControlSet_t    *picture_control_set_ptr,
+    EbObjectWrapper_t      *picture_control_set_wrapper_ptr,
     SequenceControlSet_t   *sequence_control_set_ptr) {
 
     EbObjectWrapper_t             *outputReconWrapperPtr;
@@ -702,75 +703,105 @@ static void ReconOutput(
         }
 
         // End running the film grain
-        // Y Recon Samples
-        sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom)) << is16bit;
-        reconReadPtr = recon_ptr->buffer_y + (recon_ptr->origin_y << is16bit) * recon_ptr->stride_y + (recon_ptr->origin_x << is16bit);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize Y recon buffer
-        picture_copy_kernel(
-            reconReadPtr,
-            recon_ptr->stride_y,
-            reconWritePtr,
-            recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right,
-            recon_ptr->width - sequence_control_set_ptr->pad_right,
-            recon_ptr->height - sequence_control_set_ptr->pad_bottom,
-            1 << is16bit);
-
-        outputReconPtr->n_filled_len += sampleTotalCount;
-
-        // U Recon Samples
-        sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
-        reconReadPtr = recon_ptr->bufferCb + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->strideCb + ((recon_ptr->origin_x << is16bit) >> 1);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize U recon buffer
-        picture_copy_kernel(
-            reconReadPtr,
-            recon_ptr->strideCb,
-            reconWritePtr,
-            (recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
-            (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
-            (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
-            1 << is16bit);
-        outputReconPtr->n_filled_len += sampleTotalCount;
-
-        // V Recon Samples
-        sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
-        reconReadPtr = recon_ptr->bufferCr + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->strideCr + ((recon_ptr->origin_x << is16bit) >> 1);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize V recon buffer
-
-        picture_copy_kernel(
-            reconReadPtr,
-            recon_ptr->strideCr,
-            reconWritePtr,
-            (recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
-            (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
-            (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
-            1 << is16bit);
-        outputReconPtr->n_filled_len += sampleTotalCount;
+        if (sequence_control_set_ptr->static_config.recon_zero_copy) {
+            // Hand out the picture itself: lock the object that owns recon_ptr
+            // (reference object, or the child PCS for non-reference and film
+            // grain pictures) until the application releases the view
+            EbReconView_t *reconViewPtr = (EbReconView_t*)outputReconPtr->p_buffer;
+            reconViewPtr->picture_wrapper_ptr = (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && !sequence_control_set_ptr->film_grain_params_present) ?
+                picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr :
+                picture_control_set_wrapper_ptr;
+            eb_object_inc_live_count(
+                reconViewPtr->picture_wrapper_ptr,
+                1);
+
+            reconViewPtr->planes.luma = recon_ptr->buffer_y + ((recon_ptr->origin_y * recon_ptr->stride_y + recon_ptr->origin_x) << is16bit);
+            reconViewPtr->planes.cb = recon_ptr->bufferCb + (((recon_ptr->origin_y >> 1) * recon_ptr->strideCb + (recon_ptr->origin_x >> 1)) << is16bit);
+            reconViewPtr->planes.cr = recon_ptr->bufferCr + (((recon_ptr->origin_y >> 1) * recon_ptr->strideCr + (recon_ptr->origin_x >> 1)) << is16bit);
+            reconViewPtr->planes.lumaExt = NULL;
+            reconViewPtr->planes.cbExt = NULL;
+            reconViewPtr->planes.crExt = NULL;
+            reconViewPtr->planes.yStride = recon_ptr->stride_y;
+            reconViewPtr->planes.cbStride = recon_ptr->strideCb;
+            reconViewPtr->planes.crStride = recon_ptr->strideCr;
+            reconViewPtr->planes.width = recon_ptr->width - sequence_control_set_ptr->pad_right;
+            reconViewPtr->planes.height = recon_ptr->height - sequence_control_set_ptr->pad_bottom;
+            reconViewPtr->planes.origin_x = 0;
+            reconViewPtr->planes.origin_y = 0;
+            outputReconPtr->n_filled_len = sizeof(EbSvtIOFormat);
+        }
+        else {
+            // Y Recon Samples
+            sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom)) << is16bit;
+            reconReadPtr = recon_ptr->buffer_y + (recon_ptr->origin_y << is16bit) * recon_ptr->stride_y + (recon_ptr->origin_x << is16bit);
+            reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+            CHECK_REPORT_ERROR(
+                (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+                encode_context_ptr->app_callback_ptr,
+                EB_ENC_ROB_OF_ERROR);
+
+            // Initialize Y recon buffer
+            picture_copy_kernel(
+                reconReadPtr,
+                recon_ptr->stride_y,
+                reconWritePtr,
+                recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right,
+                recon_ptr->width - sequence_control_set_ptr->pad_right,
+                recon_ptr->height - sequence_control_set_ptr->pad_bottom,
+                1 << is16bit);
+
+            outputReconPtr->n_filled_len += sampleTotalCount;
+
+            // U Recon Samples
+            sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+            reconReadPtr = recon_ptr->bufferCb + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->strideCb + ((recon_ptr->origin_x << is16bit) >> 1);
+            reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+            CHECK_REPORT_ERROR(
+                (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+                encode_context_ptr->app_callback_ptr,
+                EB_ENC_ROB_OF_ERROR);
+
+            // Initialize U recon buffer
+            picture_copy_kernel(
+                reconReadPtr,
+                recon_ptr->strideCb,
+                reconWritePtr,
+                (recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
+                (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
+                (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+                1 << is16bit);
+            outputReconPtr->n_filled_len += sampleTotalCount;
+
+            // V Recon Samples
+            sampleTotalCount = ((recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (recon_ptr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+            reconReadPtr = recon_ptr->bufferCr + ((recon_ptr->origin_y << is16bit) >> 1) * recon_ptr->strideCr + ((recon_ptr->origin_x << is16bit) >> 1);
+            reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+            CHECK_REPORT_ERROR(
+                (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+                encode_context_ptr->app_callback_ptr,
+                EB_ENC_ROB_OF_ERROR);
+
+            // Initialize V recon buffer
+
+            picture_copy_kernel(
+                reconReadPtr,
+                recon_ptr->strideCr,
+                reconWritePtr,
+                (recon_ptr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
+                (recon_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
+                (recon_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+                1 << is16bit);
+            outputReconPtr->n_filled_len += sampleTotalCount;
+        }
         outputReconPtr->pts = picture_control_set_ptr->picture_number;
     }
 
     // Post the Recon object
     eb_post_full_object(outputReconWrapperPtr);
+    encode_context_notify_output(encode_context_ptr, EB_OUTPUT_RECON);
     eb_release_mutex(encode_context_ptr->total_number_of_recon_frame_mutex);
 }
 
@@ -879,7 +910,35 @@ void PsnrCalculations(
         EbByte  inputBufferBitInc;
         uint16_t*  reconCoeffBuffer;
 
-        if (sequence_control_set_ptr->static_config.ten_bit_format == 1) {
+        if (input_picture_ptr->buffer_16bit_y) {
+            // Native 16bit input
+            uint16_t *inputBuffers[3] = {
+                &input_picture_ptr->buffer_16bit_y[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y],
+                &input_picture_ptr->buffer_16bit_cb[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCb],
+                &input_picture_ptr->buffer_16bit_cr[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCr] };
+            uint16_t *reconBuffers[3] = {
+                (uint16_t*)(&((recon_ptr->buffer_y)[(recon_ptr->origin_x << is16bit) + (recon_ptr->origin_y << is16bit) * recon_ptr->stride_y])),
+                (uint16_t*)(&((recon_ptr->bufferCb)[(recon_ptr->origin_x << is16bit) / 2 + (recon_ptr->origin_y << is16bit) / 2 * recon_ptr->strideCb])),
+                (uint16_t*)(&((recon_ptr->bufferCr)[(recon_ptr->origin_x << is16bit) / 2 + (recon_ptr->origin_y << is16bit) / 2 * recon_ptr->strideCr])) };
+            const uint32_t inputStrides[3] = { input_picture_ptr->stride_y, input_picture_ptr->strideCb, input_picture_ptr->strideCr };
+            const uint32_t reconStrides[3] = { recon_ptr->stride_y, recon_ptr->strideCb, recon_ptr->strideCr };
+            uint32_t planeIndex;
+
+            for (planeIndex = 0; planeIndex < 3; ++planeIndex) {
+                const uint32_t planeWidth = planeIndex ? sequence_control_set_ptr->chroma_width : sequence_control_set_ptr->luma_width;
+                const uint32_t planeHeight = planeIndex ? sequence_control_set_ptr->chroma_height : sequence_control_set_ptr->luma_height;
+
+                residualDistortion = 0;
+                for (row_index = 0; row_index < planeHeight; ++row_index) {
+                    for (columnIndex = 0; columnIndex < planeWidth; ++columnIndex)
+                        residualDistortion += (int64_t)SQR((int64_t)inputBuffers[planeIndex][columnIndex] - reconBuffers[planeIndex][columnIndex]);
+                    inputBuffers[planeIndex] += inputStrides[planeIndex];
+                    reconBuffers[planeIndex] += reconStrides[planeIndex];
+                }
+                sseTotal[planeIndex] = residualDistortion;
+            }
+        }
+        else if (sequence_control_set_ptr->static_config.ten_bit_format == 1) {
 
             const uint32_t luma_width = sequence_control_set_ptr->luma_width;
             const uint32_t luma_height = sequence_control_set_ptr->luma_height;
@@ -1593,6 +1652,7 @@ void* EncDecKernel(void *input_ptr)
                         context_ptr->ss_mecontext->search_area_height = 64;
 
                         // perform in-loop ME
+                        MD_PROFILER_START(in_loop_me_start);
                         in_loop_motion_estimation_sblock(
                             picture_control_set_ptr,
                             sb_origin_x,
@@ -1602,8 +1662,11 @@ void* EncDecKernel(void *input_ptr)
                             mv_l1_x,
                             mv_l1_y,
                             context_ptr->ss_mecontext);
+                        MD_PROFILER_STOP(context_ptr->md_context, picture_control_set_ptr->enc_mode, MD_PROFILER_IN_LOOP_ME,
+                            sequence_control_set_ptr->sb_size_pix == 128 ? BLOCK_128X128 : BLOCK_64X64, in_loop_me_start);
                     }
 
+                    MD_PROFILER_START(mode_decision_sb_start);
                     mode_decision_sb(
                         sequence_control_set_ptr,
                         picture_control_set_ptr,
@@ -1614,6 +1677,8 @@ void* EncDecKernel(void *input_ptr)
                         sb_index,
                         context_ptr->ss_mecontext,
                         context_ptr->md_context);
+                    MD_PROFILER_STOP(context_ptr->md_context, picture_control_set_ptr->enc_mode, MD_PROFILER_SB,
+                        sequence_control_set_ptr->sb_size_pix == 128 ? BLOCK_128X128 : BLOCK_64X64, mode_decision_sb_start);
 
 
                     // Configure the LCU
@@ -1949,6 +2014,7 @@ void* EncDecKernel(void *input_ptr)
             if (sequence_control_set_ptr->static_config.recon_enabled) {
                 ReconOutput(
                     picture_control_set_ptr,
+                    encDecTasksPtr->pictureControlSetWrapperPtr,
                     sequence_control_set_ptr);
             }
 #endif
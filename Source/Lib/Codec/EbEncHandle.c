@@ -64,6 +64,7 @@
 #include "EbSvtAv1Enc.h"
 #include "EbThreads.h"
 #include "EbUtility.h"
+#include "EbSvtAv1Time.h"
 #include "EbEncHandle.h"
 #include "EbSystemResourceManager.h"
 #include "EbPictureControlSet.h"
@@ -95,6 +96,7 @@
 #include "EbEncDecResults.h"
 #include "EbEntropyCodingResults.h"
 #include "EbPredictionStructure.h"
+#include "RateControlTwoPass.h"
 #if FILT_PROC
 #include "EbDlfProcess.h"
 #include "EbCdefProcess.h"
@@ -113,6 +115,9 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #endif
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
 
 
 #define RTCD_C
@@ -135,11 +140,15 @@
 #define EB_RateControlProcessInitCount                  1
 #define EB_PacketizationProcessInitCount                1
 
+// Picture Pools Initial Counts, the remaining objects are constructed on first use
+#define LAZY_POOL_INIT_COUNT(scs_ptr, total_count)      ((scs_ptr)->static_config.lazy_pool_allocation ? 1 : (total_count))
+
 // Output Buffer Transfer Parameters
 #define EB_OUTPUTSTREAMBUFFERSIZE                                       0x2DC6C0   //0x7D00        // match MTU Size
 #define EB_OUTPUTRECONBUFFERSIZE                                        (MAX_PICTURE_WIDTH_SIZE*MAX_PICTURE_HEIGHT_SIZE*2)   // Recon Slice Size
 #define EB_OUTPUTSTATISTICSBUFFERSIZE                                   0x30            // 6X8 (8 Bytes for Y, U, V, number of bits, picture number, QP)
 #define EOS_NAL_BUFFER_SIZE                                             0x0010 // Bitstream used to code EOS NAL
+#define EB_SEND_PICTURES_BATCH_SIZE                                     16     // Input buffers reserved at once by eb_svt_enc_send_pictures
 #define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x1E8480 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x2DC6C0 : 0x2DC6C0  )   
 
 #define ENCDEC_INPUT_PORT_MDC                                0
@@ -331,56 +340,70 @@ uint64_t GetAffinityMask(uint32_t lpnum) {
 }
 #endif
 
-void EbSetThreadManagementParameters(EbSvtAv1EncConfiguration   *config_ptr) {
-    uint32_t num_logical_processors = GetNumProcessors();
+/**********************************
+* Derive the thread affinity of an encoder
+* from its configuration
+**********************************/
 #ifdef _WIN32
+static void DeriveThreadAffinity(
+    EbSvtAv1EncConfiguration   *config_ptr,
+    GROUP_AFFINITY             *affinity_ptr,
+    EbBool                     *alternate_groups_ptr)
+{
+    uint32_t num_logical_processors = GetNumProcessors();
     // For system with a single processor group(no more than 64 logic processors all together)
     // Affinity of the thread can be set to one or more logical processors
     if (num_groups == 1) {
         uint32_t lps = config_ptr->logical_processors == 0 ? num_logical_processors :
             config_ptr->logical_processors < num_logical_processors ? config_ptr->logical_processors : num_logical_processors;
-        group_affinity.Mask = GetAffinityMask(lps);
+        affinity_ptr->Mask = GetAffinityMask(lps);
     }
     else if (num_groups > 1) { // For system with multiple processor group
         if (config_ptr->logical_processors == 0) {
             if (config_ptr->target_socket != -1) {
-                group_affinity.Group = config_ptr->target_socket;
+                affinity_ptr->Group = config_ptr->target_socket;
             }
         }
         else {
             uint32_t num_lp_per_group = num_logical_processors / num_groups;
             if (config_ptr->target_socket == -1) {
                 if (config_ptr->logical_processors > num_lp_per_group) {
-                    alternate_groups = TRUE;
+                    *alternate_groups_ptr = EB_TRUE;
                     SVT_LOG("SVT [WARNING]: -lp(logical processors) setting is ignored. Run on both sockets. \n");
                 }
                 else {
-                    group_affinity.Mask = GetAffinityMask(config_ptr->logical_processors);
+                    affinity_ptr->Mask = GetAffinityMask(config_ptr->logical_processors);
                 }
             }
             else {
                 uint32_t lps = config_ptr->logical_processors == 0 ? num_lp_per_group :
                     config_ptr->logical_processors < num_lp_per_group ? config_ptr->logical_processors : num_lp_per_group;
-                group_affinity.Mask = GetAffinityMask(lps);
-                group_affinity.Group = config_ptr->target_socket;
+                affinity_ptr->Mask = GetAffinityMask(lps);
+                affinity_ptr->Group = config_ptr->target_socket;
             }
         }
     }
+}
 #elif defined(__linux__)
-    CPU_ZERO(&group_affinity);
+static void DeriveThreadAffinity(
+    EbSvtAv1EncConfiguration   *config_ptr,
+    cpu_set_t                  *affinity_ptr)
+{
+    uint32_t num_logical_processors = GetNumProcessors();
+    CPU_ZERO(affinity_ptr);
 
     if (num_groups == 1) {
         uint32_t lps = config_ptr->logical_processors == 0 ? num_logical_processors :
             config_ptr->logical_processors < num_logical_processors ? config_ptr->logical_processors : num_logical_processors;
         for (uint32_t i = 0; i < lps; i++)
-            CPU_SET(lp_group[0].group[i], &group_affinity);
+            CPU_SET(lp_group[0].group[i], affinity_ptr);
     }
     else if (num_groups > 1) {
         uint32_t num_lp_per_group = num_logical_processors / num_groups;
         if (config_ptr->logical_processors == 0) {
             if (config_ptr->target_socket != -1) {
                 for (uint32_t i = 0; i < lp_group[config_ptr->target_socket].num; i++)
-                    CPU_SET(lp_group[config_ptr->target_socket].group[i], &group_affinity);
+                    CPU_SET(lp_group[config_ptr->target_socket].group[i], affinity_ptr);
             }
         }
         else {
@@ -388,24 +411,36 @@ void EbSetThreadManagementParameters(EbSvtAv1EncConfiguration   *config_ptr) {
                 uint32_t lps = config_ptr->logical_processors == 0 ? num_logical_processors :
                     config_ptr->logical_processors < num_logical_processors ? config_ptr->logical_processors : num_logical_processors;
                 if (lps > num_lp_per_group) {
-                    for (uint32_t i = 0; i < lp_group[0].num; i++)
-                        CPU_SET(lp_group[0].group[i], &group_affinity);
-                    for (uint32_t i = 0; i < (lps - lp_group[0].num); i++)
-                        CPU_SET(lp_group[1].group[i], &group_affinity);
+                    // Spill over as many sockets as needed, filling each one before the next
+                    uint32_t assigned = 0;
+                    for (uint32_t socket_id = 0; socket_id < num_groups && assigned < lps; socket_id++) {
+                        for (uint32_t i = 0; i < lp_group[socket_id].num && assigned < lps; i++, assigned++)
+                            CPU_SET(lp_group[socket_id].group[i], affinity_ptr);
+                    }
                 }
                 else {
                     for (uint32_t i = 0; i < lps; i++)
-                        CPU_SET(lp_group[0].group[i], &group_affinity);
+                        CPU_SET(lp_group[0].group[i], affinity_ptr);
                 }
             }
             else {
                 uint32_t lps = config_ptr->logical_processors == 0 ? num_lp_per_group :
                     config_ptr->logical_processors < num_lp_per_group ? config_ptr->logical_processors : num_lp_per_group;
                 for (uint32_t i = 0; i < lps; i++)
-                    CPU_SET(lp_group[config_ptr->target_socket].group[i], &group_affinity);
+                    CPU_SET(lp_group[config_ptr->target_socket].group[i], affinity_ptr);
             }
         }
     }
+}
+#endif
+
+void EbSetThreadManagementParameters(EbSvtAv1EncConfiguration   *config_ptr) {
+#ifdef _WIN32
+    DeriveThreadAffinity(config_ptr, &group_affinity, &alternate_groups);
+#elif defined(__linux__)
+    DeriveThreadAffinity(config_ptr, &group_affinity);
+#else
+    (void)config_ptr;
 #endif
 }
 void asmSetConvolveAsmTable(void);
@@ -432,6 +467,10 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config) {
         uint32_t ppcs_count     = fps;
         uint32_t min_ppcs_count = (2 << config->hierarchical_levels) + 1; // min picture count to start encoding
 
+        // Low delay keeps as few pictures as possible in flight
+        if (config->pred_structure == EB_PRED_LOW_DELAY_P)
+            return (int32_t) min_ppcs_count;
+
         fps        = fps > 120 ? 120   : fps;
         fps        = fps < 24  ? 24    : fps; 
         ppcs_count = MAX(min_ppcs_count, fps);
@@ -461,6 +500,8 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
     if (return_ppcs == -1)
         return EB_ErrorInsufficientResources;
     uint32_t inputPic = (uint32_t)return_ppcs;
+    // Low delay does not look at future pictures for scene changes
+    uint32_t scdLad = sequence_control_set_ptr->static_config.pred_structure == EB_PRED_LOW_DELAY_P ? 0 : SCD_LAD;
 
     unsigned int lpCount = GetNumProcessors();
     unsigned int coreCount = lpCount;
@@ -487,7 +528,7 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
 #endif
 
     sequence_control_set_ptr->input_buffer_fifo_init_count         = 
-        inputPic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance ;
+        inputPic + scdLad + sequence_control_set_ptr->static_config.look_ahead_distance ;
     sequence_control_set_ptr->output_stream_buffer_fifo_init_count = 
         sequence_control_set_ptr->input_buffer_fifo_init_count + 4;
 
@@ -537,12 +578,15 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
     //#====================== Data Structures and Picture Buffers ======================
     sequence_control_set_ptr->picture_control_set_pool_init_count       = inputPic;
     sequence_control_set_ptr->picture_control_set_pool_init_count_child = MAX(MAX(MIN(3, coreCount/2), coreCount / 6), 1);
+    // One more for the recon view of a non-reference picture, which holds its child PCS
+    if (sequence_control_set_ptr->static_config.recon_zero_copy)
+        sequence_control_set_ptr->picture_control_set_pool_init_count_child++;
     sequence_control_set_ptr->reference_picture_buffer_init_count       = MAX((uint32_t)(inputPic >> 1),
                                                                           (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
-                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + scdLad;
     sequence_control_set_ptr->pa_reference_picture_buffer_init_count    = MAX((uint32_t)(inputPic >> 1),
                                                                           (uint32_t)((1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2)) +
-                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + scdLad;
     sequence_control_set_ptr->output_recon_buffer_fifo_init_count       = sequence_control_set_ptr->reference_picture_buffer_init_count;
 
     //#====================== Inter process Fifos ======================
@@ -588,6 +632,12 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
 #endif
 
     sequence_control_set_ptr->total_process_init_count += 6; // single processes count
+
+    // PA segments: without a lookahead few pictures are in flight, so split each picture
+    // in SB rows over the PA workers to cut its analysis latency
+    sequence_control_set_ptr->pa_segment_row_count = sequence_control_set_ptr->static_config.pred_structure == EB_PRED_RANDOM_ACCESS ? 1 :
+        MAX(1, MIN(MIN(sequence_control_set_ptr->picture_analysis_process_init_count, SEGMENT_MAX_COUNT),
+        (sequence_control_set_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64));
     printf("Number of logical cores available: %u\nNumber of PPCS %u\n", coreCount, inputPic);
 
     return return_error;
@@ -690,6 +740,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->memory_map = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
     encHandlePtr->memory_map_index = 0;
     encHandlePtr->total_lib_memory = sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
+    encHandlePtr->output_event_fd = -1;
 
     // Save Memory Map Pointers 
     total_lib_memory = &encHandlePtr->total_lib_memory;
@@ -893,16 +944,10 @@ EbErrorType RestResultsCtor(
 }
 #endif
 /**********************************
-* Initialize Encoder Library
+* Construct Encoder Pools, Contexts and Threads
 **********************************/
-#if defined(__linux__) || defined(__APPLE__)
-__attribute__((visibility("default")))
-#endif
-EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+static EbErrorType init_encoder_resources(EbEncHandle_t *encHandlePtr)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instanceIndex;
     uint32_t processIndex;
@@ -977,6 +1022,18 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         maxLookAheadDistance = MAX(maxLookAheadDistance, encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.look_ahead_distance);
     }
 
+    // First pass statistics
+    for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
+        if (encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.pass == 1) {
+            return_error = two_pass_stats_ctor(
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr,
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr);
+            if (return_error == EB_ErrorInsufficientResources) {
+                return EB_ErrorInsufficientResources;
+            }
+        }
+    }
+
 
     for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
 
@@ -1005,16 +1062,23 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
         inputData.in_loop_me_flag = (uint8_t)encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.in_loop_me_flag;
 
-        return_error = eb_system_resource_ctor(
+        // The init data outlives the constructor when the pool is lazily allocated
+        PictureControlSetInitData_t *parentInitDataPtr;
+        EB_MALLOC(PictureControlSetInitData_t*, parentInitDataPtr, sizeof(PictureControlSetInitData_t), EB_N_PTR);
+        *parentInitDataPtr = inputData;
+
+        return_error = eb_system_resource_lazy_ctor(
             &(encHandlePtr->pictureParentControlSetPoolPtrArray[instanceIndex]),
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count,//encHandlePtr->pictureControlSetPoolTotalCount,
+            LAZY_POOL_INIT_COUNT(encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr,
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count),
             1,
             0,
             &encHandlePtr->pictureParentControlSetPoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             picture_parent_control_set_ctor,
-            &inputData);
+            parentInitDataPtr);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1055,16 +1119,23 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         inputData.sb_size_pix = scs_init.sb_size;
         inputData.max_depth = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->max_sb_depth;
         inputData.is16bit = is16bit;
-        return_error = eb_system_resource_ctor(
+
+        PictureControlSetInitData_t *childInitDataPtr;
+        EB_MALLOC(PictureControlSetInitData_t*, childInitDataPtr, sizeof(PictureControlSetInitData_t), EB_N_PTR);
+        *childInitDataPtr = inputData;
+
+        return_error = eb_system_resource_lazy_ctor(
             &(encHandlePtr->pictureControlSetPoolPtrArray[instanceIndex]),
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
+            LAZY_POOL_INIT_COUNT(encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr,
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count_child),
             1,
             0,
             &encHandlePtr->pictureControlSetPoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             picture_control_set_ctor,
-            &inputData);
+            childInitDataPtr);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1093,8 +1164,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
 
-        EbReferenceObjectDescInitData_t     EbReferenceObjectDescInitDataStructure;
-        EbPaReferenceObjectDescInitData_t   EbPaReferenceObjectDescInitDataStructure;
+        EbReferenceObjectDescInitData_t    *EbReferenceObjectDescInitDataPtr;
+        EbPaReferenceObjectDescInitData_t  *EbPaReferenceObjectDescInitDataPtr;
         EbPictureBufferDescInitData_t       referencePictureBufferDescInitData;
         EbPictureBufferDescInitData_t       quarterDecimPictureBufferDescInitData;
         EbPictureBufferDescInitData_t       sixteenthDecimPictureBufferDescInitData;
@@ -1116,19 +1187,22 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             referencePictureBufferDescInitData.bit_depth = EB_10BIT;
         }
 
-        EbReferenceObjectDescInitDataStructure.referencePictureDescInitData = referencePictureBufferDescInitData;
+        EB_MALLOC(EbReferenceObjectDescInitData_t*, EbReferenceObjectDescInitDataPtr, sizeof(EbReferenceObjectDescInitData_t), EB_N_PTR);
+        EbReferenceObjectDescInitDataPtr->referencePictureDescInitData = referencePictureBufferDescInitData;
 
         // Reference Picture Buffers
-        return_error = eb_system_resource_ctor(
+        return_error = eb_system_resource_lazy_ctor(
             &encHandlePtr->referencePicturePoolPtrArray[instanceIndex],
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->reference_picture_buffer_init_count,//encHandlePtr->referencePicturePoolTotalCount,
+            LAZY_POOL_INIT_COUNT(encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr,
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->reference_picture_buffer_init_count),
             EB_PictureManagerProcessInitCount,
             0,
             &encHandlePtr->referencePicturePoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             eb_reference_object_ctor,
-            &(EbReferenceObjectDescInitDataStructure));
+            EbReferenceObjectDescInitDataPtr);
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -1168,21 +1242,24 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         sixteenthDecimPictureBufferDescInitData.bot_padding = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->sb_sz >> 2;
         sixteenthDecimPictureBufferDescInitData.splitMode = EB_FALSE;
 
-        EbPaReferenceObjectDescInitDataStructure.referencePictureDescInitData = referencePictureBufferDescInitData;
-        EbPaReferenceObjectDescInitDataStructure.quarterPictureDescInitData = quarterDecimPictureBufferDescInitData;
-        EbPaReferenceObjectDescInitDataStructure.sixteenthPictureDescInitData = sixteenthDecimPictureBufferDescInitData;
+        EB_MALLOC(EbPaReferenceObjectDescInitData_t*, EbPaReferenceObjectDescInitDataPtr, sizeof(EbPaReferenceObjectDescInitData_t), EB_N_PTR);
+        EbPaReferenceObjectDescInitDataPtr->referencePictureDescInitData = referencePictureBufferDescInitData;
+        EbPaReferenceObjectDescInitDataPtr->quarterPictureDescInitData = quarterDecimPictureBufferDescInitData;
+        EbPaReferenceObjectDescInitDataPtr->sixteenthPictureDescInitData = sixteenthDecimPictureBufferDescInitData;
 
         // Reference Picture Buffers
-        return_error = eb_system_resource_ctor(
+        return_error = eb_system_resource_lazy_ctor(
             &encHandlePtr->paReferencePicturePoolPtrArray[instanceIndex],
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->pa_reference_picture_buffer_init_count,
+            LAZY_POOL_INIT_COUNT(encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr,
+                encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->pa_reference_picture_buffer_init_count),
             EB_PictureDecisionProcessInitCount,
             0,
             &encHandlePtr->paReferencePicturePoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             eb_pa_reference_object_ctor,
-            &(EbPaReferenceObjectDescInitDataStructure));
+            EbPaReferenceObjectDescInitDataPtr);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1813,13 +1890,43 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+
     /************************************
-    * Thread Handles
+    * Core Budget
     ************************************/
-    EbSvtAv1EncConfiguration   *config_ptr = &encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+    // The kernels hold a core of the budget shared with the other encoders from
+    // the dequeue of a task until they block again. The application side
+    // resources (output stream and recon) are not charged.
+    if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.core_budget) {
+        EbSystemResource_t *kernel_input_resources[] = {
+            encHandlePtr->input_buffer_resource_ptr,
+            encHandlePtr->resourceCoordinationResultsResourcePtr,
+            encHandlePtr->pictureAnalysisResultsResourcePtr,
+            encHandlePtr->pictureDecisionResultsResourcePtr,
+            encHandlePtr->motionEstimationResultsResourcePtr,
+            encHandlePtr->initialRateControlResultsResourcePtr,
+            encHandlePtr->pictureDemuxResultsResourcePtr,
+            encHandlePtr->rateControlTasksResourcePtr,
+            encHandlePtr->rateControlResultsResourcePtr,
+            encHandlePtr->encDecTasksResourcePtr,
+            encHandlePtr->encDecResultsResourcePtr,
+#if FILT_PROC
+            encHandlePtr->dlfResultsResourcePtr,
+            encHandlePtr->cdefResultsResourcePtr,
+            encHandlePtr->restResultsResourcePtr,
+#endif
+            encHandlePtr->entropyCodingResultsResourcePtr };
+        EbHandle core_budget = eb_core_budget_ctor(encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.core_budget);
 
-    EbSetThreadManagementParameters(config_ptr);
+        if (core_budget == (EbHandle)EB_NULL)
+            return EB_ErrorInsufficientResources;
+        for (uint32_t resource_index = 0; resource_index < sizeof(kernel_input_resources) / sizeof(kernel_input_resources[0]); ++resource_index)
+            kernel_input_resources[resource_index]->core_budget = core_budget;
+    }
 
+    /************************************
+    * Thread Handles
+    ************************************/
     // Resource Coordination
     EB_CREATETHREAD(EbHandle, encHandlePtr->resourceCoordinationThreadHandle, sizeof(EbHandle), EB_THREAD, resource_coordination_kernel, encHandlePtr->resourceCoordinationContextPtr);
 
@@ -1910,6 +2017,74 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     return return_error;
 }
 
+/**********************************
+* Initialize Encoder Library
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EbSvtAv1EncConfiguration   *config_ptr = &encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+    EbErrorType return_error;
+    uint64_t init_finish_seconds, init_finish_u_seconds;
+    double init_time_ms;
+
+    // Time to first packet is measured from here, and only reported with the stat report
+    EbStartTime(&encHandlePtr->init_start_seconds, &encHandlePtr->init_start_u_seconds);
+    encHandlePtr->first_packet_reported = config_ptr->stat_report ? EB_FALSE : EB_TRUE;
+
+    EbSetThreadManagementParameters(config_ptr);
+#ifdef _WIN32
+    encHandlePtr->thread_affinity = group_affinity;
+    encHandlePtr->thread_alternate_groups = alternate_groups;
+#elif defined(__linux__)
+    encHandlePtr->thread_affinity = group_affinity;
+#endif
+    encHandlePtr->thread_logical_processors = config_ptr->logical_processors;
+
+#if defined(__linux__)
+    // Pools and contexts are initialized by the calling thread, so with first
+    // touch placement their pages land on the node this thread runs on. Bind it
+    // to the target socket while constructing them to keep them node-local.
+    cpu_set_t caller_affinity;
+    const uint64_t unbound_lib_memory = encHandlePtr->total_lib_memory;
+    const EbBool bind_init_thread = (EbBool)(config_ptr->target_socket != -1 && num_groups > 1 &&
+        pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &caller_affinity) == 0);
+    if (bind_init_thread)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &group_affinity);
+#endif
+
+    return_error = init_encoder_resources(encHandlePtr);
+
+#if defined(__linux__)
+    if (bind_init_thread) {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &caller_affinity);
+        // Only the pages the constructors touch are placed by this thread, the
+        // others land where the encoder threads first touch them
+        SVT_LOG("SVT [config]: %.2f MB of encoder memory allocated while bound to socket %d\n",
+            (double)(encHandlePtr->total_lib_memory - unbound_lib_memory) / (1 << 20), config_ptr->target_socket);
+    }
+#endif
+
+    if (config_ptr->stat_report) {
+        EbFinishTime(&init_finish_seconds, &init_finish_u_seconds);
+        EbComputeOverallElapsedTimeMs(
+            encHandlePtr->init_start_seconds,
+            encHandlePtr->init_start_u_seconds,
+            init_finish_seconds,
+            init_finish_u_seconds,
+            &init_time_ms);
+        SVT_LOG("SVT [timing]: encoder initialized in %.0f ms, %.2f MB allocated%s\n",
+            init_time_ms, (double)encHandlePtr->total_lib_memory / (1 << 20),
+            config_ptr->lazy_pool_allocation ? " (picture pools grow on demand)" : "");
+    }
+    return return_error;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -1926,6 +2101,87 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component)
     EbMemoryMapEntry*   memoryEntry = (EbMemoryMapEntry*)EB_NULL;
 
     if (encHandlePtr) {
+        // EncDec threads are created once all the contexts are constructed
+        if (encHandlePtr->encDecThreadHandleArray) {
+            const EbBool stat_report = (EbBool)encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.stat_report;
+            uint64_t interp_search_pred_count = 0;
+            uint64_t interp_search_pred_saved_count = 0;
+            uint64_t tx_search_type_count = 0;
+            uint64_t tx_search_type_pruned_count = 0;
+            uint64_t intra_edge_build_count = 0;
+            uint64_t intra_edge_reuse_count = 0;
+            uint64_t intra_filtered_edge_build_count = 0;
+            uint64_t intra_filtered_edge_reuse_count = 0;
+            for (uint32_t processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex) {
+                EncDecContext_t *enc_dec_context_ptr = (EncDecContext_t*)encHandlePtr->encDecContextPtrArray[processIndex];
+                interp_search_pred_count += enc_dec_context_ptr->md_context->interp_search_pred_count;
+                interp_search_pred_saved_count += enc_dec_context_ptr->md_context->interp_search_pred_saved_count;
+                tx_search_type_count += enc_dec_context_ptr->md_context->tx_search_type_count;
+                tx_search_type_pruned_count += enc_dec_context_ptr->md_context->tx_search_type_pruned_count;
+                for (uint32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
+                    IntraEdgeCache_t *edge_cache = &enc_dec_context_ptr->md_context->intra_edge_cache[plane];
+                    intra_edge_build_count += edge_cache->base_build_count;
+                    intra_edge_reuse_count += edge_cache->base_reuse_count;
+                    intra_filtered_edge_build_count += edge_cache->variant_build_count;
+                    intra_filtered_edge_reuse_count += edge_cache->variant_reuse_count;
+                }
+            }
+            if (stat_report && interp_search_pred_count + interp_search_pred_saved_count)
+                SVT_LOG("SVT [stats]: interpolation filter search: %llu predictions, %llu saved (%.1f%%)\n",
+                    (unsigned long long)interp_search_pred_count, (unsigned long long)interp_search_pred_saved_count,
+                    100.0 * interp_search_pred_saved_count / (interp_search_pred_count + interp_search_pred_saved_count));
+            if (stat_report && tx_search_type_count + tx_search_type_pruned_count)
+                SVT_LOG("SVT [stats]: tx type search: %llu tx types evaluated, %llu pruned (%.1f%%)\n",
+                    (unsigned long long)tx_search_type_count, (unsigned long long)tx_search_type_pruned_count,
+                    100.0 * tx_search_type_pruned_count / (tx_search_type_count + tx_search_type_pruned_count));
+            if (stat_report && intra_edge_build_count)
+                SVT_LOG("SVT [stats]: intra edge cache: %llu edges built, %llu reused (%.1f%%), %llu filtered edges built, %llu reused (%.1f%%)\n",
+                    (unsigned long long)intra_edge_build_count, (unsigned long long)intra_edge_reuse_count,
+                    100.0 * intra_edge_reuse_count / (intra_edge_build_count + intra_edge_reuse_count),
+                    (unsigned long long)intra_filtered_edge_build_count, (unsigned long long)intra_filtered_edge_reuse_count,
+                    100.0 * intra_filtered_edge_reuse_count / MAX(1, intra_filtered_edge_build_count + intra_filtered_edge_reuse_count));
+
+#if MD_PROFILER
+            {
+                MdProfiler_t *md_profiler = (MdProfiler_t*)calloc(1, sizeof(MdProfiler_t));
+                if (md_profiler) {
+                    for (uint32_t processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex)
+                        md_profiler_accumulate(md_profiler, &((EncDecContext_t*)encHandlePtr->encDecContextPtrArray[processIndex])->md_context->md_profiler);
+                    md_profiler_report(md_profiler);
+                    free(md_profiler);
+                }
+            }
+#endif
+
+#if ADAPTIVE_ME_SEARCH_AREA
+            if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.stat_report) {
+                uint64_t searched_area_sum = 0;
+                uint64_t default_search_area_sum = 0;
+                uint64_t searched_sb_count = 0;
+                for (uint32_t processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->motion_estimation_process_init_count; ++processIndex) {
+                    MeContext_t *me_context_ptr = ((MotionEstimationContext_t*)encHandlePtr->motionEstimationContextPtrArray[processIndex])->me_context_ptr;
+                    searched_area_sum += me_context_ptr->searched_area_sum;
+                    default_search_area_sum += me_context_ptr->default_search_area_sum;
+                    searched_sb_count += me_context_ptr->searched_sb_count;
+                }
+                if (searched_sb_count)
+                    SVT_LOG("SVT [stats]: ME search area: %llu SBs, average %.1f positions per SB, %.1f with the static search areas\n",
+                        (unsigned long long)searched_sb_count,
+                        (double)searched_area_sum / searched_sb_count,
+                        (double)default_search_area_sum / searched_sb_count);
+            }
+#endif
+
+            EncodeContext_t *encode_context_ptr = encHandlePtr->sequence_control_set_instance_array[0]->encode_context_ptr;
+            if (stat_report &&
+                encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.pred_structure == EB_PRED_LOW_DELAY_P &&
+                encode_context_ptr->latency_frame_count)
+                SVT_LOG("SVT [stats]: send to packet latency: %llu frames, average %.1f ms, max %u ms\n",
+                    (unsigned long long)encode_context_ptr->latency_frame_count,
+                    (double)encode_context_ptr->total_latency_ms / encode_context_ptr->latency_frame_count,
+                    encode_context_ptr->max_latency_ms);
+        }
+
         if (encHandlePtr->memory_map_index) {
             // Loop through the ptr table and free all malloc'd pointers per channel
             for (ptrIndex = (encHandlePtr->memory_map_index) - 1; ptrIndex >= 0; --ptrIndex) {
@@ -1950,6 +2206,9 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component)
                 case EB_MUTEX:
                     eb_destroy_mutex(memoryEntry->ptr);
                     break;
+                case EB_LAZY_OBJECTS:
+                    eb_system_resource_release_lazy_objects((EbSystemResource_t*)memoryEntry->ptr);
+                    break;
                 default:
                     return_error = EB_ErrorMax;
                     break;
@@ -1960,6 +2219,13 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component)
             }
 
         }
+#ifdef __linux__
+        // Closed once the encoder threads are gone
+        if (encHandlePtr->output_event_fd >= 0) {
+            close(encHandlePtr->output_event_fd);
+            encHandlePtr->output_event_fd = -1;
+        }
+#endif
     }
     return return_error;
 }
@@ -2021,6 +2287,11 @@ EbErrorType eb_h265_enc_component_de_init(EbComponentType  *svt_enc_component)
     EbErrorType       return_error = EB_ErrorNone;
 
     if (svt_enc_component->pComponentPrivate) {
+#ifdef __linux__
+        // eb_deinit_encoder was not called
+        if (((EbEncHandle_t *)svt_enc_component->pComponentPrivate)->output_event_fd >= 0)
+            close(((EbEncHandle_t *)svt_enc_component->pComponentPrivate)->output_event_fd);
+#endif
         free((EbEncHandle_t *)svt_enc_component->pComponentPrivate);
     }
     else {
@@ -2099,6 +2370,8 @@ static uint32_t compute_default_look_ahead(
     int32_t lad = 0;
     if (config->rate_control_mode == 0)
         lad = (2 << config->hierarchical_levels)+1;
+    else if (config->rate_control_mode == 2 || config->pass == 2)
+        lad = 0;
     else
         lad = config->intra_period_length;
 
@@ -2202,7 +2475,9 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.super_block_size       = (pComponentParameterStructure->enc_mode == ENC_M0) ? 128 : 64;
 #endif
 #endif
-    sequence_control_set_ptr->static_config.pred_structure = 2; // Hardcoded(Cleanup)
+    sequence_control_set_ptr->static_config.pred_structure = (((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pred_structure == EB_PRED_LOW_DELAY_P) ?
+        EB_PRED_LOW_DELAY_P :
+        EB_PRED_RANDOM_ACCESS;
     sequence_control_set_ptr->static_config.enable_qp_scaling_flag = 1;
 
     sequence_control_set_ptr->max_cu_size = (uint8_t)64;
@@ -2308,6 +2583,13 @@ void CopyApiFromApp(
     // Rate Control
     sequence_control_set_ptr->static_config.scene_change_detection = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->scene_change_detection;
     sequence_control_set_ptr->static_config.rate_control_mode = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->rate_control_mode;
+    sequence_control_set_ptr->static_config.pass = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pass;
+    sequence_control_set_ptr->static_config.rc_stats_buffer = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->rc_stats_buffer;
+    // The first pass encodes with the fastest preset at the configured qp
+    if (sequence_control_set_ptr->static_config.pass == 1) {
+        sequence_control_set_ptr->static_config.rate_control_mode = 0;
+        sequence_control_set_ptr->static_config.enc_mode = MAX_ENC_PRESET;
+    }
     sequence_control_set_ptr->static_config.look_ahead_distance = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->look_ahead_distance;
     sequence_control_set_ptr->static_config.frames_to_be_encoded = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frames_to_be_encoded;
     sequence_control_set_ptr->static_config.frame_rate = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frame_rate;
@@ -2323,6 +2605,8 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.min_qp_allowed = (sequence_control_set_ptr->static_config.rate_control_mode) ?
         ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->min_qp_allowed :
         0;
+    sequence_control_set_ptr->static_config.vbv_buffer_size_ms = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->vbv_buffer_size_ms;
+    sequence_control_set_ptr->static_config.vbv_initial_level_ms = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->vbv_initial_level_ms;
 
     // Misc
     sequence_control_set_ptr->static_config.encoder_bit_depth = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->encoder_bit_depth;
@@ -2347,10 +2631,13 @@ void CopyApiFromApp(
 
     sequence_control_set_ptr->static_config.channel_id = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->channel_id;
     sequence_control_set_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->active_channel_count;
+    sequence_control_set_ptr->static_config.core_budget = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->core_budget;
     sequence_control_set_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->logical_processors;
     sequence_control_set_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->target_socket;
+    sequence_control_set_ptr->static_config.lazy_pool_allocation = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->lazy_pool_allocation;
     sequence_control_set_ptr->qp = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->qp;
     sequence_control_set_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_enabled;
+    sequence_control_set_ptr->static_config.recon_zero_copy = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_zero_copy;
 
     // Extract frame rate from Numerator and Denominator if not 0
     if (sequence_control_set_ptr->static_config.frame_rate_numerator != 0 && sequence_control_set_ptr->static_config.frame_rate_denominator != 0) {
@@ -2367,6 +2654,19 @@ void CopyApiFromApp(
     else
         sequence_control_set_ptr->static_config.look_ahead_distance = cap_look_ahead_distance(&sequence_control_set_ptr->static_config);
 
+    // Low delay: flat P structure, one picture per mini GOP, released without a future window
+    // (the scene change detection then only compares the picture with the previous one)
+    if (sequence_control_set_ptr->static_config.pred_structure == EB_PRED_LOW_DELAY_P) {
+        sequence_control_set_ptr->static_config.hierarchical_levels = 0;
+        sequence_control_set_ptr->max_temporal_layers = 0;
+        sequence_control_set_ptr->static_config.base_layer_switch_mode = 1;
+        sequence_control_set_ptr->static_config.look_ahead_distance = 0;
+    }
+
+    // The first pass only collects per frame statistics at a constant qp
+    if (sequence_control_set_ptr->static_config.pass == 1)
+        sequence_control_set_ptr->static_config.look_ahead_distance = 0;
+
     return;
 }
 
@@ -2440,13 +2740,13 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->pred_structure != 2) {
-        SVT_LOG("Error instance %u: Pred Structure must be [2]\n", channelNumber + 1);
+    if (config->pred_structure != EB_PRED_LOW_DELAY_P && config->pred_structure != EB_PRED_RANDOM_ACCESS) {
+        SVT_LOG("Error instance %u: Pred Structure must be [0, 2]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->base_layer_switch_mode == 1 && config->pred_structure != 2) {
-        SVT_LOG("Error Instance %u: Base Layer Switch Mode 1 only when Prediction Structure is Random Access\n", channelNumber + 1);
+    if (config->pred_structure == EB_PRED_LOW_DELAY_P && config->rate_control_mode == 1) {
+        SVT_LOG("Error Instance %u: The low delay Pred Structure requires the rate control mode 0 or 2\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
     if (sequence_control_set_ptr->max_input_luma_width % 8 && sequence_control_set_ptr->static_config.compressed_ten_bit_format == 1) {
@@ -2484,12 +2784,12 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 #if NEW_PRED_STRUCT
-    if (config->hierarchical_levels != 3 && config->hierarchical_levels != 4) {
+    if (config->pred_structure == EB_PRED_RANDOM_ACCESS && config->hierarchical_levels != 3 && config->hierarchical_levels != 4) {
         SVT_LOG("Error instance %u: Hierarchical Levels supported [3-4]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 #else
-    if (config->hierarchical_levels != 3 ) {
+    if (config->pred_structure == EB_PRED_RANDOM_ACCESS && config->hierarchical_levels != 3 ) {
         SVT_LOG("Error instance %u: Hierarchical Levels supported [3]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -2611,8 +2911,35 @@ static EbErrorType VerifySettings(
         SVT_LOG("Error Instance %u: The constrained intra must be [0 - 1] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
-    if (config->rate_control_mode > 1) {
-        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 1] \n", channelNumber + 1);
+    if (config->rate_control_mode > 2) {
+        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rate_control_mode == 2 && (config->vbv_buffer_size_ms == 0 || config->vbv_buffer_size_ms > 10000)) {
+        SVT_LOG("Error Instance %u: The VBV buffer size must be [1 - 10000] ms \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->rate_control_mode == 2 && config->vbv_initial_level_ms > config->vbv_buffer_size_ms) {
+        SVT_LOG("Error Instance %u: The VBV initial level must be [0 - VbvBufferSize] ms \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pass > 2) {
+        SVT_LOG("Error Instance %u: The pass must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    else if (config->pass == 1 && config->frames_to_be_encoded == 0) {
+        SVT_LOG("Error Instance %u: The first pass requires the number of frames to be encoded \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    else if (config->pass == 2 && config->rate_control_mode != 1) {
+        SVT_LOG("Error Instance %u: The second pass requires the rate control mode 1 \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    else if (config->pass == 2 && two_pass_check_stats(config) != EB_ErrorNone) {
+        SVT_LOG("Error Instance %u: The first pass statistics are missing or do not match the second pass \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2683,8 +3010,24 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->target_socket != -1 && config->target_socket != 0 && config->target_socket != 1) {
-        SVT_LOG("Error instance %u: Invalid TargetSocket. TargetSocket must be [-1 - 1] \n", channelNumber + 1);
+    const int32_t max_socket = num_groups > 2 ? num_groups - 1 : 1;
+    if (config->target_socket < -1 || config->target_socket > max_socket) {
+        SVT_LOG("Error instance %u: Invalid TargetSocket. TargetSocket must be [-1 - %d] \n", channelNumber + 1, max_socket);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->core_budget > GetNumProcessors()) {
+        SVT_LOG("Error instance %u: Invalid CoreBudget. CoreBudget must be [0 - %u]\n", channelNumber + 1, GetNumProcessors());
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->recon_zero_copy > 1) {
+        SVT_LOG("Error instance %u: Invalid ReconZeroCopy flag [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->lazy_pool_allocation > 1) {
+        SVT_LOG("Error instance %u: Invalid LazyPoolAllocation flag [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2726,6 +3069,11 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->target_bit_rate = 7000000;
     config_ptr->max_qp_allowed = 63;
     config_ptr->min_qp_allowed = 0;
+    config_ptr->vbv_buffer_size_ms = 1000;
+    config_ptr->vbv_initial_level_ms = 600;
+    config_ptr->pass = 0;
+    config_ptr->rc_stats_buffer.buf = NULL;
+    config_ptr->rc_stats_buffer.sz = 0;
     config_ptr->base_layer_switch_mode = 0;
     config_ptr->enc_mode = MAX_ENC_PRESET;
     config_ptr->intra_period_length = -2;
@@ -2799,9 +3147,12 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->target_socket = -1;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
+    config_ptr->core_budget = 0;
 
     // Debug info
     config_ptr->recon_enabled = 0;
+    config_ptr->recon_zero_copy = EB_FALSE;
+    config_ptr->lazy_pool_allocation = EB_FALSE;
 
     return return_error;
 }
@@ -2841,10 +3192,23 @@ static void PrintLibParams(
     else
         SVT_LOG("\nSVT [config]: FrameRate / Gop Size\t\t\t\t\t\t: %d / %d ", config->frame_rate > 1000 ? config->frame_rate >> 16 : config->frame_rate, config->intra_period_length + 1);
     SVT_LOG("\nSVT [config]: HierarchicalLevels / BaseLayerSwitchMode / PredStructure\t\t: %d / %d / %d ", config->hierarchical_levels, config->base_layer_switch_mode, config->pred_structure);
+#if defined(__linux__)
+    if (num_groups > 1) {
+        SVT_LOG("\nSVT [config]: Sockets / TargetSocket / LogicalProcessors per socket\t\t: %d / %d / ", num_groups, config->target_socket);
+        for (uint32_t socket_id = 0; socket_id < num_groups; socket_id++)
+            SVT_LOG(socket_id + 1 < num_groups ? "%u," : "%u ", lp_group[socket_id].num);
+    }
+#endif
+    if (config->core_budget)
+        SVT_LOG("\nSVT [config]: CoreBudget / ChannelCount \t\t\t\t\t\t: %d / %d ", config->core_budget, config->active_channel_count);
     if (config->rate_control_mode == 1)
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / LookaheadDistance / SceneChange\t\t: VBR / %d / %d / %d ", config->target_bit_rate, config->look_ahead_distance, config->scene_change_detection);
+    else if (config->rate_control_mode == 2)
+        SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / VbvBufferSize / VbvInitialLevel / LookaheadDistance\t: CBR / %d / %d ms / %d ms / %d ", config->target_bit_rate, config->vbv_buffer_size_ms, config->vbv_initial_level_ms, config->look_ahead_distance);
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP  / LookaheadDistance / SceneChange\t\t\t: CQP / %d / %d / %d ", scs->qp, config->look_ahead_distance, config->scene_change_detection);
+    if (config->pass)
+        SVT_LOG("\nSVT [config]: Pass \t\t\t\t\t\t\t\t: %d ", config->pass);
 #ifdef DEBUG_BUFFERS
     SVT_LOG("\nSVT [config]: INPUT / OUTPUT \t\t\t\t\t\t\t: %d / %d", scs->input_buffer_fifo_init_count, scs->output_stream_buffer_fifo_init_count);
     SVT_LOG("\nSVT [config]: CPCS / PAREF / REF \t\t\t\t\t\t: %d / %d / %d", scs->picture_control_set_pool_init_count_child, scs->pa_reference_picture_buffer_init_count, scs->reference_picture_buffer_init_count);
@@ -2950,6 +3314,178 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
 
     return return_error;
 }
+/**********************************
+* Re-pin the threads of an encoder to the
+* logical processors of an updated configuration.
+* The affinity of the other encoders of the
+* process is left untouched
+**********************************/
+static void UpdateThreadAffinity(
+    EbEncHandle_t              *encHandlePtr,
+    EbSvtAv1EncConfiguration   *config_ptr)
+{
+#ifdef _WIN32
+    encHandlePtr->thread_alternate_groups = EB_FALSE;
+    DeriveThreadAffinity(config_ptr, &encHandlePtr->thread_affinity, &encHandlePtr->thread_alternate_groups);
+#elif defined(__linux__)
+    DeriveThreadAffinity(config_ptr, &encHandlePtr->thread_affinity);
+    // An empty set means threads are managed by the OS scheduler: give them
+    // back the logical processors the application thread may run on
+    if (CPU_COUNT(&encHandlePtr->thread_affinity) == 0 &&
+        sched_getaffinity(0, sizeof(cpu_set_t), &encHandlePtr->thread_affinity) != 0)
+        return;
+#endif
+    for (uint32_t ptrIndex = 0; ptrIndex < encHandlePtr->memory_map_index; ++ptrIndex) {
+        if (encHandlePtr->memory_map[ptrIndex].ptrType != EB_THREAD)
+            continue;
+#ifdef _WIN32
+        if (num_groups == 1)
+            SetThreadAffinityMask(encHandlePtr->memory_map[ptrIndex].ptr, encHandlePtr->thread_affinity.Mask);
+        else if (num_groups > 1) {
+            if (encHandlePtr->thread_alternate_groups)
+                encHandlePtr->thread_affinity.Group = 1 - encHandlePtr->thread_affinity.Group;
+            SetThreadGroupAffinity(encHandlePtr->memory_map[ptrIndex].ptr, &encHandlePtr->thread_affinity, NULL);
+        }
+#elif defined(__linux__)
+        pthread_setaffinity_np(*((pthread_t*)encHandlePtr->memory_map[ptrIndex].ptr), sizeof(cpu_set_t), &encHandlePtr->thread_affinity);
+#endif
+    }
+}
+
+/**********************************
+* Update Encoding Parameters at Runtime
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_update_parameter(
+    EbComponentType              *svt_enc_component,
+    EbSvtAv1EncConfiguration     *pComponentParameterStructure)
+{
+    if (svt_enc_component == NULL || pComponentParameterStructure == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle_t        *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    uint32_t              instanceIndex = 0;
+    SequenceControlSet_t *sequence_control_set_ptr = pEncCompData->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr;
+    EncodeContext_t      *encode_context_ptr = pEncCompData->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr;
+    unsigned int          channelNumber = sequence_control_set_ptr->static_config.channel_id;
+
+    if (pComponentParameterStructure->enc_mode > MAX_ENC_PRESET) {
+        SVT_LOG("Error instance %u: EncoderMode must be in the range of [0-%d]\n", channelNumber + 1, MAX_ENC_PRESET);
+        return EB_ErrorBadParameter;
+    }
+    if (sequence_control_set_ptr->static_config.rate_control_mode != 0 && pComponentParameterStructure->target_bit_rate == 0) {
+        SVT_LOG("Error instance %u: TargetBitRate must be greater than 0\n", channelNumber + 1);
+        return EB_ErrorBadParameter;
+    }
+
+    // Acquire Config Mutex
+    eb_block_on_mutex(pEncCompData->sequence_control_set_instance_array[instanceIndex]->config_mutex);
+
+    encode_context_ptr->pending_enc_mode = (EbEncMode)pComponentParameterStructure->enc_mode;
+    encode_context_ptr->pending_target_bit_rate = pComponentParameterStructure->target_bit_rate;
+    encode_context_ptr->parameter_update_pending = EB_TRUE;
+
+    // The encoder threads keep reading the static configuration, so the new
+    // logical processor count only lives in a copy of it
+    if (pComponentParameterStructure->logical_processors != pEncCompData->thread_logical_processors) {
+        EbSvtAv1EncConfiguration thread_config = sequence_control_set_ptr->static_config;
+        thread_config.logical_processors = pComponentParameterStructure->logical_processors;
+        pEncCompData->thread_logical_processors = thread_config.logical_processors;
+        UpdateThreadAffinity(
+            pEncCompData,
+            &thread_config);
+    }
+
+    // Release Config Mutex
+    eb_release_mutex(pEncCompData->sequence_control_set_instance_array[instanceIndex]->config_mutex);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Get the First Pass Statistics
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_first_pass_stats(
+    EbComponentType              *svt_enc_component,
+    EbSvtAv1FixedBuf             *stats)
+{
+    if (svt_enc_component == NULL || stats == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle_t        *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EncodeContext_t      *encode_context_ptr = pEncCompData->sequence_control_set_instance_array[0]->encode_context_ptr;
+
+    if (encode_context_ptr->first_pass_stats_buffer == NULL)
+        return EB_ErrorBadParameter;
+
+    stats->buf = encode_context_ptr->first_pass_stats_buffer;
+    stats->sz = encode_context_ptr->first_pass_stats_size;
+
+    return EB_ErrorNone;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_set_output_callback(
+    EbComponentType              *svt_enc_component,
+    EbOutputReadyCallback         callback,
+    void                         *app_data)
+{
+    if (svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle_t        *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EncodeContext_t      *encode_context_ptr = pEncCompData->sequence_control_set_instance_array[0]->encode_context_ptr;
+
+    // The encoder threads read the callback without locking
+    if (pEncCompData->encDecThreadHandleArray)
+        return EB_ErrorBadParameter;
+
+    encode_context_ptr->output_ready_callback = callback;
+    encode_context_ptr->output_ready_callback_data = app_data;
+
+    return EB_ErrorNone;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_output_event_fd(
+    EbComponentType              *svt_enc_component,
+    int32_t                      *fd)
+{
+    if (svt_enc_component == NULL || fd == NULL)
+        return EB_ErrorBadParameter;
+
+#ifdef __linux__
+    EbEncHandle_t        *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EncodeContext_t      *encode_context_ptr = pEncCompData->sequence_control_set_instance_array[0]->encode_context_ptr;
+
+    if (encode_context_ptr->output_event_fd < 0) {
+        // The encoder threads read the fd without locking
+        if (pEncCompData->encDecThreadHandleArray)
+            return EB_ErrorBadParameter;
+        encode_context_ptr->output_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (encode_context_ptr->output_event_fd < 0)
+            return EB_ErrorInsufficientResources;
+        // Owned by the handle, closed even if the encoder is never deinitialized
+        pEncCompData->output_event_fd = encode_context_ptr->output_event_fd;
+    }
+    *fd = encode_context_ptr->output_event_fd;
+
+    return EB_ErrorNone;
+#else
+    *fd = -1;
+    return EB_ErrorUndefined;
+#endif
+}
+
 #if defined(__linux__) || defined(__APPLE__)
 __attribute__((visibility("default")))
 #endif
@@ -3096,11 +3632,12 @@ static EbErrorType CopyFrameBuffer(
         }
 
     }
-    else { // 10bit packed 
+    else { // 10bit packed: kept as 16bit samples, the 8bit planes are derived by the picture analysis
 
-        uint32_t lumaOffset = 0, chromaOffset = 0;
         uint32_t lumaBufferOffset = (input_picture_ptr->stride_y*sequence_control_set_ptr->top_padding + sequence_control_set_ptr->left_padding);
         uint32_t chromaBufferOffset = (input_picture_ptr->strideCr*(sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1));
+        uint16_t lumaStride = input_picture_ptr->stride_y;
+        uint16_t chromaStride = input_picture_ptr->strideCb;
         uint16_t lumaWidth = (uint16_t)(input_picture_ptr->width - sequence_control_set_ptr->max_input_pad_right);
         uint16_t chromaWidth = (lumaWidth >> 1);
         uint16_t lumaHeight = (uint16_t)(input_picture_ptr->height - sequence_control_set_ptr->max_input_pad_bottom);
@@ -3109,38 +3646,26 @@ static EbErrorType CopyFrameBuffer(
         uint16_t sourceCrStride = (uint16_t)(inputPtr->crStride);
         uint16_t sourceCbStride = (uint16_t)(inputPtr->cbStride);
 
-        un_pack2d(
-            (uint16_t*)(inputPtr->luma + lumaOffset),
-            sourceLumaStride,
-            input_picture_ptr->buffer_y + lumaBufferOffset,
-            input_picture_ptr->stride_y,
-            input_picture_ptr->bufferBitIncY + lumaBufferOffset,
-            input_picture_ptr->strideBitIncY,
-            lumaWidth,
-            lumaHeight,
-            config->asm_type);
-
-        un_pack2d(
-            (uint16_t*)(inputPtr->cb + chromaOffset),
-            sourceCbStride,
-            input_picture_ptr->bufferCb + chromaBufferOffset,
-            input_picture_ptr->strideCb,
-            input_picture_ptr->bufferBitIncCb + chromaBufferOffset,
-            input_picture_ptr->strideBitIncCb,
-            chromaWidth,
-            (lumaHeight >> 1),
-            config->asm_type);
-
-        un_pack2d(
-            (uint16_t*)(inputPtr->cr + chromaOffset),
-            sourceCrStride,
-            input_picture_ptr->bufferCr + chromaBufferOffset,
-            input_picture_ptr->strideCr,
-            input_picture_ptr->bufferBitIncCr + chromaBufferOffset,
-            input_picture_ptr->strideBitIncCr,
-            chromaWidth,
-            (lumaHeight >> 1),
-            config->asm_type);
+        // Y
+        for (inputRowIndex = 0; inputRowIndex < lumaHeight; inputRowIndex++) {
+            EB_MEMCPY((input_picture_ptr->buffer_16bit_y + lumaBufferOffset + lumaStride * inputRowIndex),
+                ((uint16_t*)inputPtr->luma + sourceLumaStride * inputRowIndex),
+                lumaWidth * sizeof(uint16_t));
+        }
+
+        // U
+        for (inputRowIndex = 0; inputRowIndex < lumaHeight >> 1; inputRowIndex++) {
+            EB_MEMCPY((input_picture_ptr->buffer_16bit_cb + chromaBufferOffset + chromaStride * inputRowIndex),
+                ((uint16_t*)inputPtr->cb + sourceCbStride * inputRowIndex),
+                chromaWidth * sizeof(uint16_t));
+        }
+
+        // V
+        for (inputRowIndex = 0; inputRowIndex < lumaHeight >> 1; inputRowIndex++) {
+            EB_MEMCPY((input_picture_ptr->buffer_16bit_cr + chromaBufferOffset + chromaStride * inputRowIndex),
+                ((uint16_t*)inputPtr->cr + sourceCrStride * inputRowIndex),
+                chromaWidth * sizeof(uint16_t));
+        }
     }
     return return_error;
 }
@@ -3194,6 +3719,59 @@ EB_API EbErrorType eb_svt_enc_send_picture(
 
     return EB_ErrorNone;
 }
+
+/**********************************
+* Empty These Buffers
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_send_pictures(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType  **p_buffers,
+    uint32_t              count)
+{
+    EbEncHandle_t          *encHandlePtr;
+    SequenceControlSet_t   *sequence_control_set_ptr;
+    EbObjectWrapper_t      *ebWrapperArray[EB_SEND_PICTURES_BATCH_SIZE];
+    uint32_t                sentCount = 0;
+    uint32_t                wrapperCount;
+    uint32_t                wrapperIndex;
+
+    if (svt_enc_component == NULL || (p_buffers == NULL && count))
+        return EB_ErrorBadParameter;
+    for (wrapperIndex = 0; wrapperIndex < count; ++wrapperIndex) {
+        if (p_buffers[wrapperIndex] == NULL)
+            return EB_ErrorBadParameter;
+    }
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    sequence_control_set_ptr = encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+
+    while (sentCount < count) {
+        // Reserve the input buffers available, at least one
+        eb_get_empty_objects(
+            encHandlePtr->input_buffer_producer_fifo_ptr_array[0],
+            ebWrapperArray,
+            MIN(count - sentCount, EB_SEND_PICTURES_BATCH_SIZE),
+            &wrapperCount);
+
+        for (wrapperIndex = 0; wrapperIndex < wrapperCount; ++wrapperIndex) {
+            CopyInputBuffer(
+                sequence_control_set_ptr,
+                (EbBufferHeaderType*)ebWrapperArray[wrapperIndex]->object_ptr,
+                p_buffers[sentCount + wrapperIndex]);
+        }
+
+        eb_post_full_objects(
+            ebWrapperArray,
+            wrapperCount);
+
+        sentCount += wrapperCount;
+    }
+
+    return EB_ErrorNone;
+}
 static void CopyOutputReconBuffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -3214,6 +3792,41 @@ static void CopyOutputReconBuffer(
 
     return;
 }
+static void CopyOutputReconView(
+    EbBufferHeaderType   *dst,
+    EbBufferHeaderType   *src,
+    uint32_t              bytesPerSample)
+{
+    EbSvtIOFormat *planes = &((EbReconView_t*)src->p_buffer)->planes;
+    const uint32_t lumaRowSize = planes->width * bytesPerSample;
+    const uint32_t chromaRowSize = (planes->width >> 1) * bytesPerSample;
+    uint32_t row;
+
+    dst->size = src->size;
+    dst->p_app_private = src->p_app_private;
+    dst->n_tick_count = src->n_tick_count;
+    dst->pts = src->pts;
+    dst->dts = src->dts;
+    dst->flags = src->flags;
+    dst->pic_type = src->pic_type;
+    dst->n_filled_len = 0;
+
+    if (dst->n_alloc_len < (lumaRowSize * planes->height) + 2 * chromaRowSize * (planes->height >> 1))
+        return;
+
+    for (row = 0; row < planes->height; ++row) {
+        EB_MEMCPY(dst->p_buffer + dst->n_filled_len, planes->luma + row * planes->yStride * bytesPerSample, lumaRowSize);
+        dst->n_filled_len += lumaRowSize;
+    }
+    for (row = 0; row < (planes->height >> 1); ++row) {
+        EB_MEMCPY(dst->p_buffer + dst->n_filled_len, planes->cb + row * planes->cbStride * bytesPerSample, chromaRowSize);
+        dst->n_filled_len += chromaRowSize;
+    }
+    for (row = 0; row < (planes->height >> 1); ++row) {
+        EB_MEMCPY(dst->p_buffer + dst->n_filled_len, planes->cr + row * planes->crStride * bytesPerSample, chromaRowSize);
+        dst->n_filled_len += chromaRowSize;
+    }
+}
 
 /**********************************
 * eb_svt_get_packet sends out packet
@@ -3243,6 +3856,20 @@ EB_API EbErrorType eb_svt_get_packet(
 
         packet = (EbBufferHeaderType*)ebWrapperPtr->object_ptr;
 
+        if (!pEncCompData->first_packet_reported) {
+            uint64_t first_packet_seconds, first_packet_u_seconds;
+            double first_packet_time_ms;
+            EbFinishTime(&first_packet_seconds, &first_packet_u_seconds);
+            EbComputeOverallElapsedTimeMs(
+                pEncCompData->init_start_seconds,
+                pEncCompData->init_start_u_seconds,
+                first_packet_seconds,
+                first_packet_u_seconds,
+                &first_packet_time_ms);
+            SVT_LOG("SVT [timing]: time to first packet %.0f ms\n", first_packet_time_ms);
+            pEncCompData->first_packet_reported = EB_TRUE;
+        }
+
         if (packet->flags != EB_BUFFERFLAG_EOS &&
             packet->flags != EB_BUFFERFLAG_SHOW_EXT &&
             packet->flags != EB_BUFFERFLAG_HAS_TD &&
@@ -3301,9 +3928,19 @@ EB_API EbErrorType eb_svt_get_recon(
 
         if (ebWrapperPtr) {
             EbBufferHeaderType* objPtr = (EbBufferHeaderType*)ebWrapperPtr->object_ptr;
-            CopyOutputReconBuffer(
-                p_buffer,
-                objPtr);
+            SequenceControlSet_t *sequence_control_set_ptr = pEncCompData->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+            if (sequence_control_set_ptr->static_config.recon_zero_copy) {
+                CopyOutputReconView(
+                    p_buffer,
+                    objPtr,
+                    (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT) ? 2 : 1);
+                eb_release_object(((EbReconView_t*)objPtr->p_buffer)->picture_wrapper_ptr);
+            }
+            else {
+                CopyOutputReconBuffer(
+                    p_buffer,
+                    objPtr);
+            }
 
             if (p_buffer->flags != EB_BUFFERFLAG_EOS && p_buffer->flags != 0) {
                 return_error = EB_ErrorMax;
@@ -3322,6 +3959,64 @@ EB_API EbErrorType eb_svt_get_recon(
     return return_error;
 }
 
+/**********************************
+* Recon View (zero-copy recon output)
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_recon_view(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType  **p_buffer)
+{
+    EbErrorType           return_error = EB_ErrorNone;
+    EbEncHandle_t          *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EbObjectWrapper_t      *ebWrapperPtr = NULL;
+    EbSvtAv1EncConfiguration *config = &pEncCompData->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+
+    if (config->recon_enabled && config->recon_zero_copy) {
+
+        eb_get_full_object_non_blocking(
+            (pEncCompData->output_recon_buffer_consumer_fifo_ptr_dbl_array[0])[0],
+            &ebWrapperPtr);
+
+        if (ebWrapperPtr) {
+            *p_buffer = (EbBufferHeaderType*)ebWrapperPtr->object_ptr;
+
+            // save the wrapper pointer for the release
+            (*p_buffer)->wrapper_ptr = (void*)ebWrapperPtr;
+
+            if ((*p_buffer)->flags != EB_BUFFERFLAG_EOS && (*p_buffer)->flags != 0) {
+                return_error = EB_ErrorMax;
+            }
+        }
+        else {
+            return_error = EB_NoErrorEmptyQueue;
+        }
+    }
+    else {
+        // zero-copy recon is not enabled
+        return_error = EB_ErrorMax;
+    }
+
+    return return_error;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API void eb_svt_release_recon_view(
+    EbBufferHeaderType  **p_buffer)
+{
+    if (p_buffer && *p_buffer && (*p_buffer)->wrapper_ptr) {
+        // Unlock the viewed picture, then return the view into the pool
+        eb_release_object(((EbReconView_t*)(*p_buffer)->p_buffer)->picture_wrapper_ptr);
+        eb_release_object((EbObjectWrapper_t  *)(*p_buffer)->wrapper_ptr);
+        *p_buffer = NULL;
+    }
+    return;
+}
+
 /**********************************
 * Encoder Error Handling
 **********************************/
@@ -3345,6 +4040,11 @@ void lib_svt_encoder_send_error_exit(
     outputPacket->p_buffer   = NULL;
 
     eb_post_full_object(ebWrapperPtr);
+
+    // Wake the callback and eventfd waiters up, as for any other packet
+    encode_context_notify_output(
+        pEncCompData->sequence_control_set_instance_array[0]->encode_context_ptr,
+        EB_OUTPUT_PACKET);
 }
 /**********************************
 * Encoder Handle Initialization
@@ -3413,6 +4113,12 @@ static EbErrorType allocate_frame_buffer(
     if (is16bit && config->compressed_ten_bit_format == 1) {
         input_picture_buffer_desc_init_data.splitMode = EB_FALSE;  //do special allocation for 2bit data down below.        
     }
+    else if (is16bit) {
+        // Native 16bit input: 8bit planes only, the 16bit planes are allocated down below.
+        // The 8bit planes are derived from them by the picture analysis.
+        input_picture_buffer_desc_init_data.splitMode = EB_FALSE;
+        input_picture_buffer_desc_init_data.bit_depth = EB_8BIT;
+    }
 
     // Enhanced Picture Buffer
     return_error = eb_picture_buffer_desc_ctor(
@@ -3429,6 +4135,16 @@ static EbErrorType allocate_frame_buffer(
         EB_ALLIGN_MALLOC(uint8_t*, ((EbPictureBufferDesc_t*)(inputBuffer->p_buffer))->bufferBitIncCb, sizeof(uint8_t) * (input_picture_buffer_desc_init_data.maxWidth / 8)*(input_picture_buffer_desc_init_data.maxHeight / 2), EB_A_PTR);
         EB_ALLIGN_MALLOC(uint8_t*, ((EbPictureBufferDesc_t*)(inputBuffer->p_buffer))->bufferBitIncCr, sizeof(uint8_t) * (input_picture_buffer_desc_init_data.maxWidth / 8)*(input_picture_buffer_desc_init_data.maxHeight / 2), EB_A_PTR);
     }
+    else if (is16bit) {
+        EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)inputBuffer->p_buffer;
+        input_picture_ptr->bit_depth = (EB_BITDEPTH)config->encoder_bit_depth;
+        EB_ALLIGN_MALLOC(uint16_t*, input_picture_ptr->buffer_16bit_y, sizeof(uint16_t) * input_picture_ptr->lumaSize, EB_A_PTR);
+        EB_ALLIGN_MALLOC(uint16_t*, input_picture_ptr->buffer_16bit_cb, sizeof(uint16_t) * input_picture_ptr->chromaSize, EB_A_PTR);
+        EB_ALLIGN_MALLOC(uint16_t*, input_picture_ptr->buffer_16bit_cr, sizeof(uint16_t) * input_picture_ptr->chromaSize, EB_A_PTR);
+        EB_MEMSET(input_picture_ptr->buffer_16bit_y, 0, sizeof(uint16_t) * input_picture_ptr->lumaSize);
+        EB_MEMSET(input_picture_ptr->buffer_16bit_cb, 0, sizeof(uint16_t) * input_picture_ptr->chromaSize);
+        EB_MEMSET(input_picture_ptr->buffer_16bit_cr, 0, sizeof(uint16_t) * input_picture_ptr->chromaSize);
+    }
 
     return return_error;
 }
@@ -3497,7 +4213,10 @@ EbErrorType EbOutputReconBufferHeaderCtor(
     // both u and v
     const uint32_t chromaSize = lumaSize >> 1;
     const uint32_t tenBit = (sequence_control_set_ptr->static_config.encoder_bit_depth > 8);
-    const uint32_t frameSize = (lumaSize + chromaSize) << tenBit;
+    // Zero-copy recon only carries a view of the encoder picture
+    const uint32_t frameSize = sequence_control_set_ptr->static_config.recon_zero_copy ?
+        (uint32_t)sizeof(EbReconView_t) :
+        (lumaSize + chromaSize) << tenBit;
 
     EB_MALLOC(EbBufferHeaderType*, recon_buffer, sizeof(EbBufferHeaderType), EB_N_PTR);
     *objectDblPtr = (EbPtr)recon_buffer;
@@ -172,6 +172,23 @@ typedef struct EbEncHandle_s
     uint32_t                                memory_map_index;
     uint64_t                                total_lib_memory;
 
+    // Output eventfd, -1 until the application asks for it
+    int32_t                                 output_event_fd;
+
+    // Thread affinity of the encoder threads, re-derived by eb_svt_enc_update_parameter
+#ifdef _WIN32
+    GROUP_AFFINITY                          thread_affinity;
+    EbBool                                  thread_alternate_groups;
+#elif defined(__linux__)
+    cpu_set_t                               thread_affinity;
+#endif
+    uint32_t                                thread_logical_processors;
+
+    // Startup Timing
+    uint64_t                                init_start_seconds;
+    uint64_t                                init_start_u_seconds;
+    EbBool                                  first_packet_reported;
+
 } EbEncHandle_t;
 
 
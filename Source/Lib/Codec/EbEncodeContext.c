@@ -4,6 +4,9 @@
 */
 
 #include <stdlib.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 #include "EbDefinitions.h"
 #include "EbEncodeContext.h"
@@ -35,6 +38,11 @@ EbErrorType encode_context_ctor(
     encode_context_ptr->total_number_of_recon_frames = 0;
     encode_context_ptr->statistics_port_active = EB_FALSE;
     
+    // Output notification
+    encode_context_ptr->output_ready_callback = (EbOutputReadyCallback)EB_NULL;
+    encode_context_ptr->output_ready_callback_data = EB_NULL;
+    encode_context_ptr->output_event_fd = -1;
+
     // Output Buffer Fifos
     encode_context_ptr->stream_output_fifo_ptr = (EbFifo_t*)EB_NULL;
     encode_context_ptr->recon_output_fifo_ptr = (EbFifo_t*)EB_NULL;
@@ -235,3 +243,20 @@ EbErrorType encode_context_ctor(
     return EB_ErrorNone;
 }
 
+void encode_context_notify_output(
+    EncodeContext_t *encode_context_ptr,
+    uint32_t         output_type)
+{
+    if (encode_context_ptr->output_ready_callback)
+        encode_context_ptr->output_ready_callback(encode_context_ptr->output_ready_callback_data, output_type);
+
+#ifdef __linux__
+    if (encode_context_ptr->output_event_fd >= 0) {
+        // eventfd counter: readable until the application reads it. A write only
+        // fails on counter overflow, when the fd is readable anyway
+        uint64_t event_count = 1;
+        ssize_t  written = write(encode_context_ptr->output_event_fd, &event_count, sizeof(event_count));
+        (void)written;
+    }
+#endif
+}
@@ -40,6 +40,14 @@
 #define RC_GROUP_IN_GOP_MAX_NUMBER                          512
 #define PICTURE_IN_RC_GROUP_MAX_NUMBER                      64
 
+// Zero-copy recon output: the view handed to the application, plus the
+// wrapper (reference object or child PCS) kept alive until it is released
+typedef struct EbReconView_s
+{
+    EbSvtIOFormat                                    planes;
+    EbObjectWrapper_t                               *picture_wrapper_ptr;
+} EbReconView_t;
+
 typedef struct EncodeContext_s
 {
     // Callback Functions
@@ -49,6 +57,11 @@ typedef struct EncodeContext_s
     EbHandle                                         total_number_of_recon_frame_mutex;
     uint64_t                                         total_number_of_recon_frames;
 
+    // Output notification, set before the encoder threads start
+    EbOutputReadyCallback                            output_ready_callback;
+    void                                            *output_ready_callback_data;
+    int32_t                                          output_event_fd;
+
     // Output Buffer Fifos
     EbFifo_t                                        *stream_output_fifo_ptr;
     EbFifo_t                                        *recon_output_fifo_ptr;
@@ -135,6 +148,12 @@ typedef struct EncodeContext_s
     int64_t                                           sc_frame_out;
     EbHandle                                          sc_buffer_mutex;
     EbEncMode                                         enc_mode;
+
+    // Runtime Parameter Update (protected by the instance config_mutex,
+    // applied by resource coordination at the next mini-GOP boundary)
+    EbBool                                            parameter_update_pending;
+    EbEncMode                                         pending_enc_mode;
+    uint32_t                                          pending_target_bit_rate;
                                                      
     // Rate Control                                  
     uint32_t                                          previous_selected_ref_qp;
@@ -147,6 +166,16 @@ typedef struct EncodeContext_s
     EbObjectWrapper_t                                *previous_picture_control_set_wrapper_ptr;
     EbHandle                                          shared_reference_mutex;
 
+    // Two pass: statistics written by the first pass
+    uint8_t                                          *first_pass_stats_buffer;
+    uint64_t                                          first_pass_stats_capacity;
+    uint64_t                                          first_pass_stats_size;
+
+    // Send to packet latency of the output frames, in ms
+    uint64_t                                          latency_frame_count;
+    uint64_t                                          total_latency_ms;
+    uint32_t                                          max_latency_ms;
+
 } EncodeContext_t;
 
 typedef struct EncodeContextInitData_s {
@@ -159,4 +188,10 @@ typedef struct EncodeContextInitData_s {
 extern EbErrorType encode_context_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
+
+/* Signal the application that an output of output_type (EB_OUTPUT_PACKET or
+ * EB_OUTPUT_RECON) has been posted: call its callback, raise its event fd */
+extern void encode_context_notify_output(
+    EncodeContext_t *encode_context_ptr,
+    uint32_t         output_type);
 #endif // EbEncodeContext_h
\ No newline at end of file
@@ -1126,6 +1126,61 @@ uint8_t allowed_tx_set_b[TX_SIZES_ALL][TX_TYPES] = {
 {1,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,    0}
 };
 #endif
+
+/*********************************************************************
+ * tx_type_energy_prune
+ *   Cheap residual energy model pruning the 1D ADST / FLIPADST of the
+ *   tx search. The ADST basis functions grow away from the top / left
+ *   edge and the FLIPADST ones towards it, so each is pruned when the
+ *   residual energy is skewed to the opposite half of the block.
+ *********************************************************************/
+static uint32_t tx_type_energy_prune(
+    int16_t  *residual,
+    uint32_t  residual_stride,
+    uint32_t  width,
+    uint32_t  height,
+    int32_t  *allowed_tx_mask)
+{
+    uint64_t top_energy = 0, bottom_energy = 0;
+    uint64_t left_energy = 0, right_energy = 0;
+    uint32_t pruned_count = 0;
+
+    for (uint32_t row = 0; row < height; ++row) {
+        for (uint32_t col = 0; col < width; ++col) {
+            const int32_t sample = residual[row * residual_stride + col];
+            const uint64_t energy = (uint64_t)(sample * sample);
+            if (row < (height >> 1))
+                top_energy += energy;
+            else
+                bottom_energy += energy;
+            if (col < (width >> 1))
+                left_energy += energy;
+            else
+                right_energy += energy;
+        }
+    }
+
+    // A 1D type is pruned when the other half holds less than half of the energy
+    const EbBool prune_v_adst = top_energy > (bottom_energy << 1);
+    const EbBool prune_v_flipadst = bottom_energy > (top_energy << 1);
+    const EbBool prune_h_adst = left_energy > (right_energy << 1);
+    const EbBool prune_h_flipadst = right_energy > (left_energy << 1);
+
+    for (int32_t tx_type = DCT_DCT + 1; tx_type < TX_TYPES; ++tx_type) {
+        if (!allowed_tx_mask[tx_type])
+            continue;
+        if ((prune_v_adst && vtx_tab[tx_type] == ADST_1D) ||
+            (prune_v_flipadst && vtx_tab[tx_type] == FLIPADST_1D) ||
+            (prune_h_adst && htx_tab[tx_type] == ADST_1D) ||
+            (prune_h_flipadst && htx_tab[tx_type] == FLIPADST_1D)) {
+            allowed_tx_mask[tx_type] = 0;
+            pruned_count++;
+        }
+    }
+
+    return pruned_count;
+}
+
 void ProductFullLoopTxSearch(
     ModeDecisionCandidateBuffer_t  *candidateBuffer,
     ModeDecisionContext_t          *context_ptr,
@@ -1174,14 +1229,38 @@ void ProductFullLoopTxSearch(
     if (allowed_tx_num == 0) {
         allowed_tx_mask[plane ? uv_tx_type : DCT_DCT] = 1;
     }
+    if (picture_control_set_ptr->parent_pcs_ptr->tx_search_reduced_set) {
+        for (int32_t tx_type_index = txk_start; tx_type_index < txk_end; ++tx_type_index)
+            if (!allowed_tx_set_a[txSize][tx_type_index]) allowed_tx_mask[tx_type_index] = 0;
+    }
+
+    // Tx search pruning level                      Settings
+    // 0                                            OFF
+    // 1                                            Stop when DCT_DCT quantizes to zero
+    // 2                                            1 + residual energy based ADST / FLIPADST pruning
+    const uint8_t tx_search_prune_level = picture_control_set_ptr->parent_pcs_ptr->tx_search_prune_level;
+    if (tx_search_prune_level >= 2)
+        context_ptr->tx_search_type_pruned_count += tx_type_energy_prune(
+            &(((int16_t*)candidateBuffer->residual_ptr->buffer_y)[context_ptr->blk_geom->origin_x + (context_ptr->blk_geom->origin_y * candidateBuffer->residual_ptr->stride_y)]),
+            candidateBuffer->residual_ptr->stride_y,
+            context_ptr->blk_geom->bwidth,
+            context_ptr->blk_geom->bheight,
+            allowed_tx_mask);
+
 #if BUG_FIX
     TxType best_tx_type = DCT_DCT;
 #endif
+    uint32_t dct_dct_count_non_zero_coeffs = 0;
     for (int32_t tx_type_index = txk_start; tx_type_index < txk_end; ++tx_type_index) {
         tx_type = (TxType)tx_type_index;
         if (!allowed_tx_mask[tx_type]) continue;
-        if (picture_control_set_ptr->parent_pcs_ptr->tx_search_reduced_set)
-            if (!allowed_tx_set_a[txSize][tx_type]) continue;
+
+        // Other tx types are unlikely to win when DCT_DCT has no coefficients
+        if (tx_search_prune_level >= 1 && tx_type != DCT_DCT && allowed_tx_mask[DCT_DCT] && dct_dct_count_non_zero_coeffs == 0) {
+            context_ptr->tx_search_type_pruned_count++;
+            continue;
+        }
+        context_ptr->tx_search_type_count++;
 
         context_ptr->three_quad_energy = 0;
         uint32_t txb_itr = 0;
@@ -1232,6 +1311,8 @@ void ProductFullLoopTxSearch(
 
             candidateBuffer->candidate_ptr->quantized_dc[0] = (((int32_t*)candidateBuffer->residualQuantCoeffPtr->buffer_y)[tuOriginIndex]);
 
+            if (tx_type == DCT_DCT)
+                dct_dct_count_non_zero_coeffs += yCountNonZeroCoeffsTemp;
 
 #if TX_TYPE_FIX
             //tx_type not equal to DCT_DCT and no coeff is not an acceptable option in AV1.
@@ -405,6 +405,7 @@ void DetectGlobalMotion(
     }
 }
 
+
 /************************************************
 * Initial Rate Control Context Constructor
 ************************************************/
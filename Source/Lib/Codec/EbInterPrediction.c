@@ -3515,352 +3515,276 @@ static const int32_t filter_sets[DUAL_FILTER_SET_SIZE][2] = {
   { 1, 2 }, { 2, 0 }, { 2, 1 }, { 2, 2 },
 };
 
-/*static*/ void interpolation_filter_search(
-    PictureControlSet_t *picture_control_set_ptr,
-    EbPictureBufferDesc_t *prediction_ptr,
-    ModeDecisionContext_t *md_context_ptr,
+/* Model rd results of the predicted filter sets of one interpolation filter
+ * search. Filter sets whose filters are only applied on full-pel positions
+ * produce the same prediction, so they are keyed by their effective filters. */
+typedef struct InterpFilterRdCache_s {
+    uint8_t  valid[DUAL_FILTER_SET_SIZE];
+    int32_t  rate[DUAL_FILTER_SET_SIZE];
+    int64_t  dist[DUAL_FILTER_SET_SIZE];
+    int32_t  skip_txfm_sb[DUAL_FILTER_SET_SIZE];
+    int64_t  skip_sse_sb[DUAL_FILTER_SET_SIZE];
+    // The x (resp. y) filter is never applied when all the motion vectors
+    // are full-pel horizontally (resp. vertically), in luma and chroma
+    EbBool   x_full_pel;
+    EbBool   y_full_pel;
+} InterpFilterRdCache_t;
+
+static void interp_filter_rd_cache_init(
+    InterpFilterRdCache_t *cache,
+    MvUnit_t              *mv_unit)
+{
+    int16_t mv_x_bits = 0;
+    int16_t mv_y_bits = 0;
+
+    memset(cache->valid, 0, sizeof(cache->valid));
+    if (mv_unit->predDirection == UNI_PRED_LIST_0 || mv_unit->predDirection == BI_PRED) {
+        mv_x_bits |= mv_unit->mv[REF_LIST_0].x;
+        mv_y_bits |= mv_unit->mv[REF_LIST_0].y;
+    }
+    if (mv_unit->predDirection == UNI_PRED_LIST_1 || mv_unit->predDirection == BI_PRED) {
+        mv_x_bits |= mv_unit->mv[REF_LIST_1].x;
+        mv_y_bits |= mv_unit->mv[REF_LIST_1].y;
+    }
+    // 1/8-pel luma motion vectors, full-pel in 4:2:0 chroma when multiple of 16
+    cache->x_full_pel = (mv_x_bits & 15) == 0;
+    cache->y_full_pel = (mv_y_bits & 15) == 0;
+}
+
+/*********************************************************************
+ * interp_filter_set_rd
+ *   Predicts the block with the y_filter x x_filter filter set and
+ *   returns its model rd cost. The prediction is skipped when a
+ *   previously evaluated set has the same effective filters.
+ *********************************************************************/
+static int64_t interp_filter_set_rd(
+    PictureControlSet_t           *picture_control_set_ptr,
+    EbPictureBufferDesc_t         *prediction_ptr,
+    ModeDecisionContext_t         *md_context_ptr,
     ModeDecisionCandidateBuffer_t *candidate_buffer_ptr,
-    MvUnit_t mv_unit,
-    EbPictureBufferDesc_t  *ref_pic_list0,
-    EbPictureBufferDesc_t  *ref_pic_list1,
-    EbAsm asm_type,
-    //Macroblock *const xd,
-    //const AV1_COMP *const cpi,
-    //block_size bsize,
-    //int32_t mi_row,
-    //int32_t mi_col,
-    //const BUFFER_SET *const tmp_dst,
-    //BUFFER_SET *const orig_dst,
-    /* InterpFilter (*const single_filter)[REF_FRAMES],*/
-    int64_t *const rd,
-    int32_t *const switchable_rate,
-    int32_t *const skip_txfm_sb,
-    int64_t *const skip_sse_sb) {
+    MvUnit_t                      *mv_unit,
+    EbPictureBufferDesc_t         *ref_pic_list0,
+    EbPictureBufferDesc_t         *ref_pic_list1,
+    EbBool                         hbd,
+    int32_t                        num_planes,
+    InterpFilterRdCache_t         *cache,
+    InterpFilter                   y_filter,
+    InterpFilter                   x_filter,
+    int32_t                       *switchable_rate,
+    int32_t                       *skip_txfm_sb,
+    int64_t                       *skip_sse_sb,
+    EbAsm                          asm_type)
+{
+    const Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    const int32_t key = (cache->y_full_pel || y_filter >= SWITCHABLE_FILTERS ? EIGHTTAP_REGULAR : y_filter) * SWITCHABLE_FILTERS +
+        (cache->x_full_pel || x_filter >= SWITCHABLE_FILTERS ? EIGHTTAP_REGULAR : x_filter);
 
+    candidate_buffer_ptr->candidate_ptr->interp_filters = av1_make_interp_filters(y_filter, x_filter);
 
-    const Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;//&cpi->common;
+    *switchable_rate = av1_get_switchable_rate(
+        candidate_buffer_ptr,
+        cm,
+        md_context_ptr);
 
-    const int32_t num_planes = MAX_MB_PLANE;
+    if (cache->valid[key]) {
+        md_context_ptr->interp_search_pred_saved_count++;
+    }
+    else {
+#if INTERPOL_FILTER_SEARCH_10BIT_SUPPORT
+        if (hbd)
+            AV1InterPrediction10BitMD(
+                candidate_buffer_ptr->candidate_ptr->interp_filters,
+                picture_control_set_ptr,
+                candidate_buffer_ptr->candidate_ptr->ref_frame_type,
+                md_context_ptr,
+                md_context_ptr->cu_ptr,
+                mv_unit,
+                md_context_ptr->cu_origin_x,
+                md_context_ptr->cu_origin_y,
+                md_context_ptr->blk_geom->bwidth,
+                md_context_ptr->blk_geom->bheight,
+                ref_pic_list0,
+                ref_pic_list1,
+                prediction_ptr,
+                md_context_ptr->blk_geom->origin_x,
+                md_context_ptr->blk_geom->origin_y,
+#if CHROMA_BLIND
+                md_context_ptr->chroma_level == CHROMA_MODE_0,
+#endif
+                asm_type);
+        else
+#else
+        (void)hbd;
+#endif
+            av1_inter_prediction(
+                picture_control_set_ptr,
+                candidate_buffer_ptr->candidate_ptr->interp_filters,
+                md_context_ptr->cu_ptr,
+                candidate_buffer_ptr->candidate_ptr->ref_frame_type,
+                mv_unit,
+                md_context_ptr->cu_origin_x,
+                md_context_ptr->cu_origin_y,
+                md_context_ptr->blk_geom->bwidth,
+                md_context_ptr->blk_geom->bheight,
+                ref_pic_list0,
+                ref_pic_list1,
+                prediction_ptr,
+                md_context_ptr->blk_geom->origin_x,
+                md_context_ptr->blk_geom->origin_y,
+#if CHROMA_BLIND
+                md_context_ptr->chroma_level == CHROMA_MODE_0,
+#endif
+                asm_type);
 
-    int32_t i;
-    int32_t tmp_rate;
-    int64_t tmp_dist;
+        model_rd_for_sb(
+            picture_control_set_ptr,
+            prediction_ptr,
+            md_context_ptr,
+            0,
+            num_planes - 1,
+            &cache->rate[key],
+            &cache->dist[key],
+            &cache->skip_txfm_sb[key],
+            &cache->skip_sse_sb[key],
+            NULL, NULL, NULL);
+        cache->valid[key] = 1;
+        md_context_ptr->interp_search_pred_count++;
+    }
+
+    *skip_txfm_sb = cache->skip_txfm_sb[key];
+    *skip_sse_sb = cache->skip_sse_sb[key];
 
-    //(void)single_filter;
+    return RDCOST(md_context_ptr->full_lambda, *switchable_rate + cache->rate[key], cache->dist[key]);
+}
+
+/*********************************************************************
+ * interpolation_filter_search_common
+ *   Dual filter search: the best horizontal filter is searched with
+ *   a regular vertical filter, then the best vertical filter for it.
+ *   The vertical search is pruned when EIGHTTAP_REGULAR wins the
+ *   horizontal search by interpolation_filter_prune_th percent.
+ *********************************************************************/
+static void interpolation_filter_search_common(
+    PictureControlSet_t           *picture_control_set_ptr,
+    EbPictureBufferDesc_t         *prediction_ptr,
+    ModeDecisionContext_t         *md_context_ptr,
+    ModeDecisionCandidateBuffer_t *candidate_buffer_ptr,
+    MvUnit_t                       mv_unit,
+    EbPictureBufferDesc_t         *ref_pic_list0,
+    EbPictureBufferDesc_t         *ref_pic_list1,
+    EbBool                         hbd,
+    int32_t                        num_planes,
+    EbAsm                          asm_type,
+    int64_t *const                 rd,
+    int32_t *const                 switchable_rate,
+    int32_t *const                 skip_txfm_sb,
+    int64_t *const                 skip_sse_sb)
+{
+    const Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    InterpFilterRdCache_t cache;
+    int32_t i;
+    int32_t tmp_skip_sb;
+    int64_t tmp_skip_sse;
+    int32_t tmp_rs;
+    int64_t tmp_rd;
 
     InterpFilter assign_filter = SWITCHABLE;
 
     if (cm->interp_filter != SWITCHABLE)
         assign_filter = cm->interp_filter;
 
-    //set_default_interp_filters(mbmi, assign_filter);
-    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters =//EIGHTTAP_REGULAR ;
-        av1_broadcast_interp_filter(av1_unswitchable_filter(assign_filter));
-
-    *switchable_rate = av1_get_switchable_rate(
-        candidate_buffer_ptr,
-        cm,
-        md_context_ptr//,
-        //x,
-        //xd
-    );
+    interp_filter_rd_cache_init(&cache, &mv_unit);
 
-    av1_inter_prediction(
-        picture_control_set_ptr,
-        candidate_buffer_ptr->candidate_ptr->interp_filters,
-        md_context_ptr->cu_ptr,
-        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-        &mv_unit,
-        md_context_ptr->cu_origin_x,
-        md_context_ptr->cu_origin_y,
-        md_context_ptr->blk_geom->bwidth,
-        md_context_ptr->blk_geom->bheight,
-        ref_pic_list0,
-        ref_pic_list1,
-        prediction_ptr,
-        md_context_ptr->blk_geom->origin_x,
-        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-        asm_type);
+    // The default filter is evaluated first. The other filters are only searched
+    // when switchable, so the default one is EIGHTTAP_REGULAR when cached
+    *rd = interp_filter_set_rd(picture_control_set_ptr, prediction_ptr, md_context_ptr, candidate_buffer_ptr, &mv_unit,
+        ref_pic_list0, ref_pic_list1, hbd, num_planes, &cache,
+        av1_unswitchable_filter(assign_filter), av1_unswitchable_filter(assign_filter),
+        switchable_rate, skip_txfm_sb, skip_sse_sb, asm_type);
 
+    if (assign_filter != SWITCHABLE)
+        return;
 
-    model_rd_for_sb(
-        picture_control_set_ptr,
-        prediction_ptr,
-        md_context_ptr,
-        0,
-        num_planes - 1,
-        &tmp_rate,
-        &tmp_dist,
-        skip_txfm_sb,
-        skip_sse_sb,
-        NULL, NULL, NULL);
-
-    *rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, *switchable_rate + tmp_rate, tmp_dist);
-
-    if (assign_filter == SWITCHABLE) {
-        // do interp_filter search
-
-        if (av1_is_interp_needed(candidate_buffer_ptr, picture_control_set_ptr, md_context_ptr->blk_geom->bsize) /*&& av1_is_interp_search_needed(xd)*/) {
-
-            const int32_t filter_set_size = DUAL_FILTER_SET_SIZE;
-            int32_t best_in_temp = 0;
-            uint32_t best_filters = 0;// mbmi->interp_filters;
-
-            if (picture_control_set_ptr->parent_pcs_ptr->interpolation_search_level &&
-                picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter) {
-                int32_t tmp_skip_sb = 0;
-                int64_t tmp_skip_sse = INT64_MAX;
-                int32_t tmp_rs;
-                int64_t tmp_rd;
-
-                // default to (R,R): EIGHTTAP_REGULARxEIGHTTAP_REGULAR
-                int32_t best_dual_mode = 0;
-                // Find best of {R}x{R,Sm,Sh}
-                // EIGHTTAP_REGULAR mode is calculated beforehand
-                for (i = 1; i < SWITCHABLE_FILTERS; ++i) {
-                    tmp_skip_sb = 0;
-                    tmp_skip_sse = INT64_MAX;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = (InterpFilter)
-                        av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-                    av1_inter_prediction(
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        md_context_ptr->cu_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        best_dual_mode = i;
-
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                          restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                          restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
+    if (!av1_is_interp_needed(candidate_buffer_ptr, picture_control_set_ptr, md_context_ptr->blk_geom->bsize)) {
+        candidate_buffer_ptr->candidate_ptr->interp_filters = 0;
+        return;
+    }
 
-                // From best of horizontal EIGHTTAP_REGULAR modes, check vertical modes
-                for (i = best_dual_mode + SWITCHABLE_FILTERS; i < filter_set_size;
-                    i += SWITCHABLE_FILTERS) {
-                    tmp_skip_sb = 0;
-                    tmp_skip_sse = INT64_MAX;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters =
-                        av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-
-                    av1_inter_prediction(
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        md_context_ptr->cu_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                          restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                          restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
-            }
-            else {
-                // EIGHTTAP_REGULAR mode is calculated beforehand
-                for (i = 1; i < filter_set_size; ++i) {
-                    int32_t tmp_skip_sb = 0;
-                    int64_t tmp_skip_sse = INT64_MAX;
-                    int32_t tmp_rs;
-                    int64_t tmp_rd;
-
-                    if (/*cm->seq_params.enable_dual_filter*/picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter == 0)
-                        if (filter_sets[i][0] != filter_sets[i][1]) continue;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-
-                    av1_inter_prediction(
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        md_context_ptr->cu_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                          restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                          restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
+    uint32_t best_filters = 0;
+
+    if (picture_control_set_ptr->parent_pcs_ptr->interpolation_search_level &&
+        picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter) {
+
+        // default to (R,R): EIGHTTAP_REGULARxEIGHTTAP_REGULAR
+        int32_t best_dual_mode = 0;
+        int64_t second_best_rd = INT64_MAX;
+
+        // Find best of {R}x{R,Sm,Sh}
+        for (i = 1; i < SWITCHABLE_FILTERS; ++i) {
+            tmp_rd = interp_filter_set_rd(picture_control_set_ptr, prediction_ptr, md_context_ptr, candidate_buffer_ptr, &mv_unit,
+                ref_pic_list0, ref_pic_list1, hbd, num_planes, &cache,
+                (InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1], &tmp_rs, &tmp_skip_sb, &tmp_skip_sse, asm_type);
+
+            if (tmp_rd < *rd) {
+                second_best_rd = *rd;
+                best_dual_mode = i;
+                *rd = tmp_rd;
+                *switchable_rate = tmp_rs;
+                best_filters = candidate_buffer_ptr->candidate_ptr->interp_filters;
+                *skip_txfm_sb = tmp_skip_sb;
+                *skip_sse_sb = tmp_skip_sse;
             }
+            else if (tmp_rd < second_best_rd)
+                second_best_rd = tmp_rd;
+        }
 
-            /*if (best_in_temp) {
-              restore_dst_buf(xd, *tmp_dst, num_planes);
-            } else {
-              restore_dst_buf(xd, *orig_dst, num_planes);
-            }*/
-            /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = best_filters;
+        // Regular filtering is kept when it clearly wins the horizontal search
+        const uint8_t prune_th = picture_control_set_ptr->parent_pcs_ptr->interpolation_filter_prune_th;
+        if (prune_th && best_dual_mode == 0 && second_best_rd != INT64_MAX &&
+            (second_best_rd - *rd) * 100 > (int64_t)prune_th * *rd) {
+            md_context_ptr->interp_search_pred_saved_count += SWITCHABLE_FILTERS - 1;
         }
         else {
-            candidate_buffer_ptr->candidate_ptr->interp_filters = 0;
-
-            /*assert(mbmi->cu_ptr->interp_filters ==
-                   av1_broadcast_interp_filter(EIGHTTAP_REGULAR));*/
+            // From best of horizontal EIGHTTAP_REGULAR modes, check vertical modes
+            for (i = best_dual_mode + SWITCHABLE_FILTERS; i < DUAL_FILTER_SET_SIZE; i += SWITCHABLE_FILTERS) {
+                tmp_rd = interp_filter_set_rd(picture_control_set_ptr, prediction_ptr, md_context_ptr, candidate_buffer_ptr, &mv_unit,
+                    ref_pic_list0, ref_pic_list1, hbd, num_planes, &cache,
+                (InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1], &tmp_rs, &tmp_skip_sb, &tmp_skip_sse, asm_type);
+
+                if (tmp_rd < *rd) {
+                    *rd = tmp_rd;
+                    *switchable_rate = tmp_rs;
+                    best_filters = candidate_buffer_ptr->candidate_ptr->interp_filters;
+                    *skip_txfm_sb = tmp_skip_sb;
+                    *skip_sse_sb = tmp_skip_sse;
+                }
+            }
         }
     }
-    //  return 0;
+    else {
+        // EIGHTTAP_REGULAR mode is calculated beforehand
+        for (i = 1; i < DUAL_FILTER_SET_SIZE; ++i) {
+            if (picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter == 0)
+                if (filter_sets[i][0] != filter_sets[i][1]) continue;
+
+            tmp_rd = interp_filter_set_rd(picture_control_set_ptr, prediction_ptr, md_context_ptr, candidate_buffer_ptr, &mv_unit,
+                ref_pic_list0, ref_pic_list1, hbd, num_planes, &cache,
+                (InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1], &tmp_rs, &tmp_skip_sb, &tmp_skip_sse, asm_type);
+
+            if (tmp_rd < *rd) {
+                *rd = tmp_rd;
+                *switchable_rate = tmp_rs;
+                best_filters = candidate_buffer_ptr->candidate_ptr->interp_filters;
+                *skip_txfm_sb = tmp_skip_sb;
+                *skip_sse_sb = tmp_skip_sse;
+            }
+        }
+    }
+
+    candidate_buffer_ptr->candidate_ptr->interp_filters = best_filters;
 }
 
-#if INTERPOL_FILTER_SEARCH_10BIT_SUPPORT
-/*static*/ void interpolation_filter_search_HBD(
+/*static*/ void interpolation_filter_search(
     PictureControlSet_t *picture_control_set_ptr,
     EbPictureBufferDesc_t *prediction_ptr,
     ModeDecisionContext_t *md_context_ptr,
@@ -3869,347 +3793,65 @@ static const int32_t filter_sets[DUAL_FILTER_SET_SIZE][2] = {
     EbPictureBufferDesc_t  *ref_pic_list0,
     EbPictureBufferDesc_t  *ref_pic_list1,
     EbAsm asm_type,
-    //Macroblock *const xd,
-    //const AV1_COMP *const cpi,
-    //block_size bsize,
-    //int32_t mi_row,
-    //int32_t mi_col,
-    //const BUFFER_SET *const tmp_dst,
-    //BUFFER_SET *const orig_dst,
-    /* InterpFilter (*const single_filter)[REF_FRAMES],*/
     int64_t *const rd,
     int32_t *const switchable_rate,
     int32_t *const skip_txfm_sb,
     int64_t *const skip_sse_sb) {
 
+    interpolation_filter_search_common(
+        picture_control_set_ptr,
+        prediction_ptr,
+        md_context_ptr,
+        candidate_buffer_ptr,
+        mv_unit,
+        ref_pic_list0,
+        ref_pic_list1,
+        EB_FALSE,
+        MAX_MB_PLANE,
+        asm_type,
+        rd,
+        switchable_rate,
+        skip_txfm_sb,
+        skip_sse_sb);
+}
 
-    const Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;//&cpi->common;
+#if INTERPOL_FILTER_SEARCH_10BIT_SUPPORT
+/*static*/ void interpolation_filter_search_HBD(
+    PictureControlSet_t *picture_control_set_ptr,
+    EbPictureBufferDesc_t *prediction_ptr,
+    ModeDecisionContext_t *md_context_ptr,
+    ModeDecisionCandidateBuffer_t *candidate_buffer_ptr,
+    MvUnit_t mv_unit,
+    EbPictureBufferDesc_t  *ref_pic_list0,
+    EbPictureBufferDesc_t  *ref_pic_list1,
+    EbAsm asm_type,
+    int64_t *const rd,
+    int32_t *const switchable_rate,
+    int32_t *const skip_txfm_sb,
+    int64_t *const skip_sse_sb) {
 
 #if CHROMA_BLIND
     const int32_t num_planes = (md_context_ptr->blk_geom->has_uv && md_context_ptr->chroma_level == CHROMA_MODE_0) ? MAX_MB_PLANE : 1;
 #else
     const int32_t num_planes = md_context_ptr->blk_geom->has_uv ? MAX_MB_PLANE : 1;
 #endif
-    int32_t i;
-    int32_t tmp_rate;
-    int64_t tmp_dist;
-
-    //(void)single_filter;
-
-    InterpFilter assign_filter = SWITCHABLE;
-
-    if (cm->interp_filter != SWITCHABLE)
-        assign_filter = cm->interp_filter;
-
-    //set_default_interp_filters(mbmi, assign_filter);
-    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters =//EIGHTTAP_REGULAR ;
-        av1_broadcast_interp_filter(av1_unswitchable_filter(assign_filter));
-
-    *switchable_rate = av1_get_switchable_rate(
-        candidate_buffer_ptr,
-        cm,
-        md_context_ptr//,
-        //x,
-        //xd
-    );
 
-    AV1InterPrediction10BitMD(
-        candidate_buffer_ptr->candidate_ptr->interp_filters,
+    interpolation_filter_search_common(
         picture_control_set_ptr,
-        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
+        prediction_ptr,
         md_context_ptr,
-        md_context_ptr->cu_ptr,
-        &mv_unit,
-        md_context_ptr->cu_origin_x,
-        md_context_ptr->cu_origin_y,
-        md_context_ptr->blk_geom->bwidth,
-        md_context_ptr->blk_geom->bheight,
+        candidate_buffer_ptr,
+        mv_unit,
         ref_pic_list0,
         ref_pic_list1,
-        prediction_ptr,
-        md_context_ptr->blk_geom->origin_x,
-        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-        asm_type);
-
-    model_rd_for_sb(
-        picture_control_set_ptr,
-        prediction_ptr,
-        md_context_ptr,
-        0,
-        num_planes - 1,
-        &tmp_rate,
-        &tmp_dist,
+        EB_TRUE,
+        num_planes,
+        asm_type,
+        rd,
+        switchable_rate,
         skip_txfm_sb,
-        skip_sse_sb,
-        NULL, NULL, NULL);
-
-    *rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, *switchable_rate + tmp_rate, tmp_dist);
-
-    if (assign_filter == SWITCHABLE) {
-        // do interp_filter search
-        if (av1_is_interp_needed(candidate_buffer_ptr, picture_control_set_ptr, md_context_ptr->blk_geom->bsize) /*&& av1_is_interp_search_needed(xd)*/) {
-            const int32_t filter_set_size = DUAL_FILTER_SET_SIZE;
-            int32_t best_in_temp = 0;
-            uint32_t best_filters = 0;// mbmi->interp_filters;
-
-            if (picture_control_set_ptr->parent_pcs_ptr->interpolation_search_level &&
-                picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter) {
-                int32_t tmp_skip_sb = 0;
-                int64_t tmp_skip_sse = INT64_MAX;
-                int32_t tmp_rs;
-                int64_t tmp_rd;
-
-                // default to (R,R): EIGHTTAP_REGULARxEIGHTTAP_REGULAR
-                int32_t best_dual_mode = 0;
-                // Find best of {R}x{R,Sm,Sh}
-                // EIGHTTAP_REGULAR mode is calculated beforehand
-                for (i = 1; i < SWITCHABLE_FILTERS; ++i) {
-                    tmp_skip_sb = 0;
-                    tmp_skip_sse = INT64_MAX;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = (InterpFilter)
-                        av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-
-                    AV1InterPrediction10BitMD(
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        md_context_ptr,
-                        md_context_ptr->cu_ptr,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        best_dual_mode = i;
-
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                        restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                        restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
-
-                // From best of horizontal EIGHTTAP_REGULAR modes, check vertical modes
-                for (i = best_dual_mode + SWITCHABLE_FILTERS; i < filter_set_size;
-                    i += SWITCHABLE_FILTERS) {
-                    tmp_skip_sb = 0;
-                    tmp_skip_sse = INT64_MAX;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters =
-                        av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-
-                    AV1InterPrediction10BitMD(
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        md_context_ptr,
-                        md_context_ptr->cu_ptr,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                        restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                        restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
-            }
-            else {
-                // EIGHTTAP_REGULAR mode is calculated beforehand
-                for (i = 1; i < filter_set_size; ++i) {
-                    int32_t tmp_skip_sb = 0;
-                    int64_t tmp_skip_sse = INT64_MAX;
-                    int32_t tmp_rs;
-                    int64_t tmp_rd;
-
-                    if (/*cm->seq_params.enable_dual_filter*/picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->enable_dual_filter == 0)
-                        if (filter_sets[i][0] != filter_sets[i][1]) continue;
-
-                    /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = av1_make_interp_filters((InterpFilter)filter_sets[i][0], (InterpFilter)filter_sets[i][1]);
-
-                    tmp_rs = av1_get_switchable_rate(
-                        candidate_buffer_ptr,
-                        cm,
-                        md_context_ptr//,
-                        //x,
-                        //xd
-                    );
-                    //av1_build_inter_predictors_sb(
-                    //                              cm,
-                    //                              xd,
-                    //                              mi_row,
-                    //                              mi_col,
-                    //                              orig_dst,
-                    //                              bsize);
-
-                    AV1InterPrediction10BitMD(
-                        candidate_buffer_ptr->candidate_ptr->interp_filters,
-                        picture_control_set_ptr,
-                        candidate_buffer_ptr->candidate_ptr->ref_frame_type,
-                        md_context_ptr,
-                        md_context_ptr->cu_ptr,
-                        &mv_unit,
-                        md_context_ptr->cu_origin_x,
-                        md_context_ptr->cu_origin_y,
-                        md_context_ptr->blk_geom->bwidth,
-                        md_context_ptr->blk_geom->bheight,
-                        ref_pic_list0,
-                        ref_pic_list1,
-                        prediction_ptr,
-                        md_context_ptr->blk_geom->origin_x,
-                        md_context_ptr->blk_geom->origin_y,
-#if CHROMA_BLIND
-                        md_context_ptr->chroma_level == CHROMA_MODE_0,
-#endif
-                        asm_type);
-
-                    model_rd_for_sb(
-                        picture_control_set_ptr,
-                        prediction_ptr,
-                        md_context_ptr,
-                        0,
-                        num_planes - 1,
-                        &tmp_rate,
-                        &tmp_dist,
-                        &tmp_skip_sb,
-                        &tmp_skip_sse,
-                        NULL, NULL, NULL);
-                    tmp_rd = RDCOST(md_context_ptr->full_lambda/*x->rdmult*/, tmp_rs + tmp_rate, tmp_dist);
-
-                    if (tmp_rd < *rd) {
-                        *rd = tmp_rd;
-                        *switchable_rate = tmp_rs;
-                        best_filters = /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters;
-                        *skip_txfm_sb = tmp_skip_sb;
-                        *skip_sse_sb = tmp_skip_sse;
-                        best_in_temp = !best_in_temp;
-                        /*if (best_in_temp) {
-                        restore_dst_buf(xd, *orig_dst, num_planes);
-                        } else {
-                        restore_dst_buf(xd, *tmp_dst, num_planes);
-                        }*/
-                    }
-                }
-            }
-
-            /*if (best_in_temp) {
-            restore_dst_buf(xd, *tmp_dst, num_planes);
-            } else {
-            restore_dst_buf(xd, *orig_dst, num_planes);
-            }*/
-            /*mbmi*/candidate_buffer_ptr->candidate_ptr->interp_filters = best_filters;
-        }
-        else {
-            candidate_buffer_ptr->candidate_ptr->interp_filters = 0;
-
-            /*assert(mbmi->cu_ptr->interp_filters ==
-            av1_broadcast_interp_filter(EIGHTTAP_REGULAR));*/
-        }
-    }
-    //  return 0;
+        skip_sse_sb);
 }
-
-
 #endif
 
 EbErrorType inter_pu_prediction_av1(
@@ -4349,7 +3991,8 @@ EbErrorType inter_pu_prediction_av1(
     } else {
         candidate_buffer_ptr->candidate_ptr->interp_filters = 0;
         if (!md_context_ptr->skip_interpolation_search) {
-            if (md_context_ptr->blk_geom->bwidth > 4 && md_context_ptr->blk_geom->bheight > 4)
+            if (md_context_ptr->blk_geom->bwidth > 4 && md_context_ptr->blk_geom->bheight > 4) {
+                MD_PROFILER_START(interp_search_start);
                 interpolation_filter_search(
                     picture_control_set_ptr,
                     candidate_buffer_ptr->predictionPtrTemp,
@@ -4363,6 +4006,8 @@ EbErrorType inter_pu_prediction_av1(
                     &rs,
                     &skip_txfm_sb,
                     &skip_sse_sb);
+                MD_PROFILER_STOP(md_context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_INTERP_SEARCH, md_context_ptr->blk_geom->bsize, interp_search_start);
+            }
         }
 
         av1_inter_prediction(
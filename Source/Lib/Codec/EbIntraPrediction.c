@@ -8730,6 +8730,124 @@ void generate_intra_reference_samples(
     }
 }
 #endif
+/*********************************************
+ * Build the unfiltered edges of the MD block,
+ * extended to the above-right and bottom-left
+ * samples so that they serve all the modes
+ *********************************************/
+static void intra_edge_cache_build_base(
+    IntraEdgeCache_t *edge_cache,
+    const uint8_t *above_ref,
+    const uint8_t *left_ref,
+    TxSize tx_size,
+    int32_t n_top_px, int32_t n_topright_px,
+    int32_t n_left_px, int32_t n_bottomleft_px)
+{
+    uint8_t *const above_row = edge_cache->base.above_data + 16;
+    uint8_t *const left_col = edge_cache->base.left_data + 16;
+    const int32_t txwpx = tx_size_wide[tx_size];
+    const int32_t txhpx = tx_size_high[tx_size];
+    const int32_t num_pixels = txwpx + txhpx;
+    int32_t i;
+
+    // The neighbors are not copied again for the following candidates of the
+    // block, as long as they ask for the same edges
+    if (edge_cache->valid &&
+        edge_cache->tx_size == tx_size &&
+        edge_cache->n_top_px == n_top_px && edge_cache->n_topright_px == n_topright_px &&
+        edge_cache->n_left_px == n_left_px && edge_cache->n_bottomleft_px == n_bottomleft_px) {
+        edge_cache->base_reuse_count++;
+        return;
+    }
+
+    i = 0;
+    if (n_left_px > 0) {
+        for (; i < n_left_px; i++) left_col[i] = left_ref[i];
+        if (n_bottomleft_px > 0) {
+            assert(i == txhpx);
+            for (; i < txhpx + n_bottomleft_px; i++) left_col[i] = left_ref[i];
+        }
+        if (i < num_pixels)
+            memset(&left_col[i], left_col[i - 1], num_pixels - i);
+    }
+    else
+        memset(left_col, (n_top_px > 0) ? above_ref[0] : 129, num_pixels);
+
+    i = 0;
+    if (n_top_px > 0) {
+        memcpy(above_row, above_ref, n_top_px);
+        i = n_top_px;
+        if (n_topright_px > 0) {
+            assert(n_top_px == txwpx);
+            memcpy(above_row + txwpx, above_ref + txwpx, n_topright_px);
+            i += n_topright_px;
+        }
+        if (i < num_pixels)
+            memset(&above_row[i], above_row[i - 1], num_pixels - i);
+    }
+    else
+        memset(above_row, (n_left_px > 0) ? left_ref[0] : 127, num_pixels);
+
+    if (n_top_px > 0 && n_left_px > 0)
+        above_row[-1] = above_ref[-1];
+    else if (n_top_px > 0)
+        above_row[-1] = above_ref[0];
+    else if (n_left_px > 0)
+        above_row[-1] = left_ref[0];
+    else
+        above_row[-1] = 128;
+    left_col[-1] = above_row[-1];
+
+    edge_cache->valid = EB_TRUE;
+    edge_cache->tx_size = tx_size;
+    edge_cache->n_top_px = n_top_px;
+    edge_cache->n_topright_px = n_topright_px;
+    edge_cache->n_left_px = n_left_px;
+    edge_cache->n_bottomleft_px = n_bottomleft_px;
+    edge_cache->variant_count = 0;
+    edge_cache->variant_next = 0;
+    edge_cache->base_build_count++;
+}
+
+/*********************************************
+ * Point to the filtered edges of the given
+ * settings, or to a copy of the unfiltered
+ * edges to be filtered. Returns EB_TRUE when
+ * the edges are to be filtered
+ *********************************************/
+static EbBool intra_edge_cache_get_variant(
+    IntraEdgeCache_t *edge_cache,
+    uint64_t key,
+    uint8_t **above_row,
+    uint8_t **left_col)
+{
+    IntraEdge_t *variant;
+    uint32_t i;
+
+    if (key == 0)
+        return EB_FALSE;
+
+    for (i = 0; i < edge_cache->variant_count; i++) {
+        if (edge_cache->variant[i].key == key) {
+            *above_row = edge_cache->variant[i].above_data + 16;
+            *left_col = edge_cache->variant[i].left_data + 16;
+            edge_cache->variant_reuse_count++;
+            return EB_FALSE;
+        }
+    }
+
+    variant = &edge_cache->variant[edge_cache->variant_next];
+    edge_cache->variant_next = (edge_cache->variant_next + 1) % INTRA_EDGE_CACHE_VARIANTS;
+    edge_cache->variant_count = MIN(edge_cache->variant_count + 1, INTRA_EDGE_CACHE_VARIANTS);
+    variant->key = key;
+    memcpy(variant->above_data, edge_cache->base.above_data, INTRA_EDGE_BUFFER_SIZE);
+    memcpy(variant->left_data, edge_cache->base.left_data, INTRA_EDGE_BUFFER_SIZE);
+    *above_row = variant->above_data + 16;
+    *left_col = variant->left_data + 16;
+    edge_cache->variant_build_count++;
+    return EB_TRUE;
+}
+
 static void build_intra_predictors(
 
 
@@ -8737,6 +8855,7 @@ static void build_intra_predictors(
     ModeDecisionContext_t                  *md_context_ptr,
     STAGE       stage,
 #endif
+    IntraEdgeCache_t *edge_cache,
     uint8_t    intra_luma_left_mode,
     uint8_t    intra_luma_top_mode,
     uint8_t    intra_chroma_left_mode,
@@ -8781,8 +8900,8 @@ static void build_intra_predictors(
 #else
     DECLARE_ALIGNED(16, uint8_t, left_data[MAX_TX_SIZE * 2 + 32]);
     DECLARE_ALIGNED(16, uint8_t, above_data[MAX_TX_SIZE * 2 + 32]);
-    uint8_t *const above_row = above_data + 16;
-    uint8_t *const left_col = left_data + 16;
+    uint8_t *above_row = above_data + 16;
+    uint8_t *left_col = left_data + 16;
 #endif
     const int32_t txwpx = tx_size_wide[tx_size];
     const int32_t txhpx = tx_size_high[tx_size];
@@ -8809,6 +8928,22 @@ static void build_intra_predictors(
     assert(n_left_px >= 0);
     assert(n_bottomleft_px >= 0);
 
+    // MD: the edges of the block are built once, for all the modes, and shared
+    // by all the candidates
+    if (edge_cache) {
+        intra_edge_cache_build_base(
+            edge_cache,
+            above_ref,
+            left_ref,
+            tx_size,
+            n_top_px,
+            n_topright_px,
+            n_left_px,
+            n_bottomleft_px);
+        above_ref = above_row = edge_cache->base.above_data + 16;
+        left_ref = left_col = edge_cache->base.left_data + 16;
+    }
+
 #if INTRA_CORE_OPT 
      if (stage == ED_STAGE) {
 #endif
@@ -8828,7 +8963,7 @@ static void build_intra_predictors(
     }
 
     // NEED_LEFT
-    if (need_left) {
+    if (need_left && !edge_cache) {
         int32_t need_bottom = !!(extend_modes[mode] & NEED_BOTTOMLEFT);
         if (use_filter_intra) need_bottom = 0;
         if (is_dr_mode) need_bottom = p_angle > 180;
@@ -8855,7 +8990,7 @@ static void build_intra_predictors(
     }
 
     // NEED_ABOVE
-    if (need_above) {
+    if (need_above && !edge_cache) {
         int32_t need_right = !!(extend_modes[mode] & NEED_ABOVERIGHT);
         if (use_filter_intra) need_right = 0;
         if (is_dr_mode) need_right = p_angle < 90;
@@ -8881,7 +9016,7 @@ static void build_intra_predictors(
         }
     }
 
-    if (need_above_left) {
+    if (need_above_left && !edge_cache) {
         if (n_top_px > 0 && n_left_px > 0) {
             above_row[-1] = above_ref[-1];
         }
@@ -8935,42 +9070,70 @@ static void build_intra_predictors(
                 neighborAvailableTop ? (PredictionMode)intraTopMode : D135_PRED,
                 0);
 
+            const int32_t ab_le = need_above_left ? 1 : 0;
+            const int32_t filter_corner = p_angle != 90 && p_angle != 180 &&
+                need_above && need_left && (txwpx + txhpx >= 24);
+            int32_t strength_above = 0;
+            int32_t n_px_filter_above = 0;
+            int32_t strength_left = 0;
+            int32_t n_px_filter_left = 0;
+            int32_t n_px_upsample_above = 0;
+            int32_t n_px_upsample_left = 0;
             if (p_angle != 90 && p_angle != 180) {
-                const int32_t ab_le = need_above_left ? 1 : 0;
-                if (need_above && need_left && (txwpx + txhpx >= 24)) {
-                    filter_intra_edge_corner(above_row, left_col);
-                }
                 if (need_above && n_top_px > 0) {
-                    const int32_t strength =
+                    strength_above =
                         intra_edge_filter_strength(txwpx, txhpx, p_angle - 90, filt_type);
-                    const int32_t n_px = n_top_px + ab_le + (need_right ? txhpx : 0);
-                    av1_filter_intra_edge(above_row - ab_le, n_px, strength);
+                    n_px_filter_above = n_top_px + ab_le + (need_right ? txhpx : 0);
                 }
                 if (need_left && n_left_px > 0) {
-                    const int32_t strength = intra_edge_filter_strength(
+                    strength_left = intra_edge_filter_strength(
                         txhpx, txwpx, p_angle - 180, filt_type);
-                    const int32_t n_px = n_left_px + ab_le + (need_bottom ? txwpx : 0);
-                    av1_filter_intra_edge(left_col - ab_le, n_px, strength);
+                    n_px_filter_left = n_left_px + ab_le + (need_bottom ? txwpx : 0);
                 }
             }
             upsample_above =
                 use_intra_edge_upsample(txwpx, txhpx, p_angle - 90, filt_type);
-            if (need_above && upsample_above) {
-                const int32_t n_px = txwpx + (need_right ? txhpx : 0);
+            if (need_above && upsample_above)
+                n_px_upsample_above = txwpx + (need_right ? txhpx : 0);
+            upsample_left =
+                use_intra_edge_upsample(txhpx, txwpx, p_angle - 180, filt_type);
+            if (need_left && upsample_left)
+                n_px_upsample_left = txhpx + (need_bottom ? txwpx : 0);
+
+            // MD: the filtered edges only depend on the filter settings, shared
+            // by the angles of the same class
+            EbBool filter_edges = EB_TRUE;
+            if (edge_cache) {
+                const uint64_t key =
+                    ((uint64_t)filter_corner << 56) |
+                    ((uint64_t)strength_above << 52) | ((uint64_t)n_px_filter_above << 40) |
+                    ((uint64_t)strength_left << 36) | ((uint64_t)n_px_filter_left << 24) |
+                    ((uint64_t)n_px_upsample_above << 12) | (uint64_t)n_px_upsample_left;
+                filter_edges = intra_edge_cache_get_variant(
+                    edge_cache,
+                    key,
+                    &above_row,
+                    &left_col);
+            }
+
+            if (filter_edges) {
+                if (filter_corner)
+                    filter_intra_edge_corner(above_row, left_col);
+                if (n_px_filter_above)
+                    av1_filter_intra_edge(above_row - ab_le, n_px_filter_above, strength_above);
+                if (n_px_filter_left)
+                    av1_filter_intra_edge(left_col - ab_le, n_px_filter_left, strength_left);
+                if (n_px_upsample_above)
 #if INTRA_ASM
-                av1_upsample_intra_edge(above_row, n_px);
+                    av1_upsample_intra_edge(above_row, n_px_upsample_above);
 #else
-                av1_upsample_intra_edge_c(above_row, n_px);
+                    av1_upsample_intra_edge_c(above_row, n_px_upsample_above);
 #endif
-            }
-            upsample_left =
-                use_intra_edge_upsample(txhpx, txwpx, p_angle - 180, filt_type);
-            if (need_left && upsample_left) {
-                const int32_t n_px = txhpx + (need_bottom ? txwpx : 0);
+                if (n_px_upsample_left)
 #if INTRA_ASM
-                av1_upsample_intra_edge(left_col, n_px);
+                    av1_upsample_intra_edge(left_col, n_px_upsample_left);
 #else
-                av1_upsample_intra_edge_c(left_col, n_px);
+                    av1_upsample_intra_edge_c(left_col, n_px_upsample_left);
 #endif
             }
         }
@@ -9427,6 +9590,7 @@ extern void av1_predict_intra_block(
     ModeDecisionContext_t                  *md_context_ptr,
 #endif
     STAGE       stage,
+    IntraEdgeCache_t *edge_cache,
     uint8_t    intra_luma_left_mode,
     uint8_t    intra_luma_top_mode,
     uint8_t    intra_chroma_left_mode,
@@ -9742,6 +9906,7 @@ extern void av1_predict_intra_block(
         md_context_ptr,
         stage,
 #endif
+        edge_cache,
         intra_luma_left_mode,
         intra_luma_top_mode,
         intra_chroma_left_mode,
@@ -10046,39 +10211,42 @@ EbErrorType AV1IntraPredictionCL(
     for (int32_t plane = 0; plane <= end_plane; ++plane) {
 #endif
 #if !INTRA_CORE_OPT
-        if (plane == 0) {
-            if (md_context_ptr->cu_origin_y != 0)
-                memcpy(topNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->topArray + md_context_ptr->cu_origin_x, md_context_ptr->blk_geom->bwidth * 2);
-            if (md_context_ptr->cu_origin_x != 0)
-                memcpy(leftNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->leftArray + md_context_ptr->cu_origin_y, md_context_ptr->blk_geom->bheight * 2);
-            if (md_context_ptr->cu_origin_y != 0 && md_context_ptr->cu_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
-        }
+        // The edges are cached after the first intra candidate of the block
+        if (!md_context_ptr->intra_edge_cache[plane].valid) {
+            if (plane == 0) {
+                if (md_context_ptr->cu_origin_y != 0)
+                    memcpy(topNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->topArray + md_context_ptr->cu_origin_x, md_context_ptr->blk_geom->bwidth * 2);
+                if (md_context_ptr->cu_origin_x != 0)
+                    memcpy(leftNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->leftArray + md_context_ptr->cu_origin_y, md_context_ptr->blk_geom->bheight * 2);
+                if (md_context_ptr->cu_origin_y != 0 && md_context_ptr->cu_origin_x != 0)
+                    topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
+            }
 
-        else if (plane == 1) {
-            if (md_context_ptr->round_origin_y != 0)
-                memcpy(topNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->topArray + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
+            else if (plane == 1) {
+                if (md_context_ptr->round_origin_y != 0)
+                    memcpy(topNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->topArray + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
 
-            if (md_context_ptr->round_origin_x != 0)
+                if (md_context_ptr->round_origin_x != 0)
 
-                memcpy(leftNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
+                    memcpy(leftNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
-            if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
-        }
-        else {
-            if (md_context_ptr->round_origin_y != 0)
+                if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
+                    topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+            }
+            else {
+                if (md_context_ptr->round_origin_y != 0)
 
-                memcpy(topNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->topArray + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
+                    memcpy(topNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->topArray + md_context_ptr->round_origin_x / 2, md_context_ptr->blk_geom->bwidth_uv * 2);
 
-            if (md_context_ptr->round_origin_x != 0)
+                if (md_context_ptr->round_origin_x != 0)
 
-                memcpy(leftNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
+                    memcpy(leftNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
-            if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
+                    topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
 
 
+            }
         }
 #endif
         if (plane)
@@ -10094,6 +10262,7 @@ EbErrorType AV1IntraPredictionCL(
             md_context_ptr,
 #endif
             MD_STAGE,
+            &md_context_ptr->intra_edge_cache[plane],
             md_context_ptr->intra_luma_left_mode,
             md_context_ptr->intra_luma_top_mode,
             md_context_ptr->intra_chroma_left_mode,
@@ -313,3 +313,52 @@ void pad_input_picture(
     return;
 }
 
+/** pad_input_picture_16bit()
+is the 16bit version of pad_input_picture(). The strides and sizes are in samples.
+*/
+void pad_input_picture_16bit(
+    uint16_t  *src_pic,
+    uint32_t   src_stride,
+    uint32_t   original_src_width,
+    uint32_t   original_src_height,
+    uint32_t   pad_right,
+    uint32_t   pad_bottom)
+{
+    uint32_t   verticalIdx;
+    uint32_t   horizontalIdx;
+    uint16_t  *tempSrcPic0;
+    uint16_t  *tempSrcPic1;
+
+    if (pad_right) {
+
+        // Add padding @ the right
+        verticalIdx = original_src_height;
+        tempSrcPic0 = src_pic;
+
+        while (verticalIdx)
+        {
+            for (horizontalIdx = 0; horizontalIdx < pad_right; horizontalIdx++)
+                tempSrcPic0[original_src_width + horizontalIdx] = tempSrcPic0[original_src_width - 1];
+            tempSrcPic0 += src_stride;
+            --verticalIdx;
+        }
+    }
+
+    if (pad_bottom) {
+
+        // Add padding @ the bottom
+        verticalIdx = pad_bottom;
+        tempSrcPic0 = src_pic + (original_src_height - 1) * src_stride;
+        tempSrcPic1 = tempSrcPic0;
+
+        while (verticalIdx)
+        {
+            tempSrcPic1 += src_stride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(uint16_t)* (original_src_width + pad_right));
+            --verticalIdx;
+        }
+    }
+
+    return;
+}
+
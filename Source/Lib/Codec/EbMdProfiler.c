@@ -0,0 +1,81 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+
+#include "EbMdProfiler.h"
+
+static const char *md_profiler_section_name[MD_PROFILER_SECTION_COUNT] = {
+    "mode_decision_sb",
+    "fast loop",
+    "full loop",
+    "tx search",
+    "interpolation search",
+    "cfl alpha search",
+    "in-loop me",
+    "inter depth decision"
+};
+
+void md_profiler_accumulate(
+    MdProfiler_t       *dst,
+    const MdProfiler_t *src)
+{
+    uint32_t preset, section, bsize;
+
+    for (preset = 0; preset < MAX_SUPPORTED_MODES; preset++) {
+        for (section = 0; section < MD_PROFILER_SECTION_COUNT; section++) {
+            for (bsize = 0; bsize < BlockSizeS_ALL; bsize++) {
+                dst->cycles[preset][section][bsize] += src->cycles[preset][section][bsize];
+                dst->calls[preset][section][bsize] += src->calls[preset][section][bsize];
+            }
+        }
+    }
+}
+
+/*
+ * One line per preset and section with the total cycles and their share of the
+ * SB level work (in-loop ME and mode_decision_sb), then the breakdown per block size
+ */
+void md_profiler_report(
+    const MdProfiler_t *profiler)
+{
+    uint32_t preset, section, bsize;
+
+    for (preset = 0; preset < MAX_SUPPORTED_MODES; preset++) {
+        uint64_t sb_cycles = 0;
+
+        for (bsize = 0; bsize < BlockSizeS_ALL; bsize++)
+            sb_cycles += profiler->cycles[preset][MD_PROFILER_SB][bsize] + profiler->cycles[preset][MD_PROFILER_IN_LOOP_ME][bsize];
+        if (sb_cycles == 0)
+            continue;
+
+        for (section = 0; section < MD_PROFILER_SECTION_COUNT; section++) {
+            uint64_t cycles = 0;
+            uint64_t calls = 0;
+
+            for (bsize = 0; bsize < BlockSizeS_ALL; bsize++) {
+                cycles += profiler->cycles[preset][section][bsize];
+                calls += profiler->calls[preset][section][bsize];
+            }
+            if (calls == 0)
+                continue;
+
+            SVT_LOG("SVT [md profiler]: M%u %-20s %14llu cycles (%5.1f%%) %10llu calls\n",
+                preset, md_profiler_section_name[section],
+                (unsigned long long)cycles, 100.0 * cycles / sb_cycles, (unsigned long long)calls);
+
+            for (bsize = 0; bsize < BlockSizeS_ALL; bsize++) {
+                if (profiler->calls[preset][section][bsize] == 0)
+                    continue;
+                SVT_LOG("SVT [md profiler]: M%u %-20s   %3ux%-3u %14llu cycles %10llu calls %10llu cycles/call\n",
+                    preset, md_profiler_section_name[section],
+                    block_size_wide[bsize], block_size_high[bsize],
+                    (unsigned long long)profiler->cycles[preset][section][bsize],
+                    (unsigned long long)profiler->calls[preset][section][bsize],
+                    (unsigned long long)(profiler->cycles[preset][section][bsize] / profiler->calls[preset][section][bsize]));
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbMdProfiler_h
+#define EbMdProfiler_h
+
+#include "EbDefinitions.h"
+
+#if MD_PROFILER
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * Mode decision profiler
+     *  Cycle counters around the mode decision kernels, per block size and
+     *  per preset. Compiled in with MD_PROFILER, dumped at eb_deinit_encoder.
+     **************************************/
+    typedef enum MdProfilerSection {
+        MD_PROFILER_SB,                 // mode_decision_sb
+        MD_PROFILER_FAST_LOOP,          // ProductPerformFastLoop
+        MD_PROFILER_FULL_LOOP,          // AV1PerformFullLoop
+        MD_PROFILER_TX_SEARCH,          // ProductFullLoopTxSearch
+        MD_PROFILER_INTERP_SEARCH,      // interpolation_filter_search
+        MD_PROFILER_CFL,                // cfl_rd_pick_alpha
+        MD_PROFILER_IN_LOOP_ME,         // in_loop_motion_estimation_sblock
+        MD_PROFILER_INTER_DEPTH,        // d2_inter_depth_block_decision
+        MD_PROFILER_SECTION_COUNT
+    } MdProfilerSection;
+
+    typedef struct MdProfiler_s {
+        uint64_t    cycles[MAX_SUPPORTED_MODES][MD_PROFILER_SECTION_COUNT][BlockSizeS_ALL];
+        uint64_t    calls[MAX_SUPPORTED_MODES][MD_PROFILER_SECTION_COUNT][BlockSizeS_ALL];
+    } MdProfiler_t;
+
+#if MD_PROFILER
+    static INLINE uint64_t md_profiler_cycles(void) {
+        return __rdtsc();
+    }
+
+    static INLINE void md_profiler_add(
+        MdProfiler_t       *profiler,
+        uint8_t             preset,
+        MdProfilerSection   section,
+        block_size          bsize,
+        uint64_t            cycles)
+    {
+        profiler->cycles[preset][section][bsize] += cycles;
+        profiler->calls[preset][section][bsize]++;
+    }
+
+#define MD_PROFILER_START(start) \
+    uint64_t start = md_profiler_cycles()
+#define MD_PROFILER_STOP(context_ptr, preset, section, bsize, start) \
+    md_profiler_add(&(context_ptr)->md_profiler, (uint8_t)(preset), section, bsize, md_profiler_cycles() - (start))
+#else
+#define MD_PROFILER_START(start)
+#define MD_PROFILER_STOP(context_ptr, preset, section, bsize, start)
+#endif
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern void md_profiler_accumulate(
+        MdProfiler_t       *dst,
+        const MdProfiler_t *src);
+
+    extern void md_profiler_report(
+        const MdProfiler_t *profiler);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbMdProfiler_h
@@ -447,7 +447,8 @@ void LimitMvOverBound(
 EbErrorType PreModeDecision(
     CodingUnit_t                   *cu_ptr,
     uint32_t                          buffer_total_count,
-    ModeDecisionCandidateBuffer_t **buffer_ptr_array,
+    const uint64_t                   *fast_cost_array,
+    const uint8_t                    *candidate_type_array,
     uint32_t                         *full_candidate_total_count_ptr,
     uint8_t                          *best_candidate_index_array,
 #if USED_NFL_FEATURE_BASED
@@ -475,7 +476,7 @@ EbErrorType PreModeDecision(
         fullReconCandidateCount = MAX(1, (*full_candidate_total_count_ptr) - 1);
 
     //With N buffers, we get here with the best N-1, plus the last candidate. We need to exclude the worst, and keep the best N-1.
-    highestCost = *(buffer_ptr_array[0]->fast_cost_ptr);
+    highestCost = fast_cost_array[0];
     highestCostIndex = 0;
 
     if (buffer_total_count > 1) {
@@ -485,13 +486,13 @@ EbErrorType PreModeDecision(
             }
         }
         else {
-            for (i = 1; i < buffer_total_count; i++) {
+            // Max reduction over the contiguous costs, then the last buffer holding it
+            for (i = 1; i < buffer_total_count; i++)
+                highestCost = MAX(highestCost, fast_cost_array[i]);
+            highestCostIndex = buffer_total_count - 1;
+            while (fast_cost_array[highestCostIndex] != highestCost)
+                highestCostIndex--;
 
-                if (*(buffer_ptr_array[i]->fast_cost_ptr) >= highestCost) {
-                    highestCost = *(buffer_ptr_array[i]->fast_cost_ptr);
-                    highestCostIndex = i;
-                }
-            }
             for (i = 0; i < buffer_total_count; i++) {
 
                 if (i != highestCostIndex) {
@@ -505,19 +506,16 @@ EbErrorType PreModeDecision(
         best_candidate_index_array[0] = 0;
     for (i = 0; i < fullReconCandidateCount - 1; ++i) {
         for (j = i + 1; j < fullReconCandidateCount; ++j) {
-            if ((buffer_ptr_array[best_candidate_index_array[i]]->candidate_ptr->type == INTRA_MODE) &&
-                (buffer_ptr_array[best_candidate_index_array[j]]->candidate_ptr->type == INTER_MODE)) {
+            if ((candidate_type_array[best_candidate_index_array[i]] == INTRA_MODE) &&
+                (candidate_type_array[best_candidate_index_array[j]] == INTER_MODE)) {
                 index = best_candidate_index_array[i];
                 best_candidate_index_array[i] = (uint8_t)best_candidate_index_array[j];
                 best_candidate_index_array[j] = (uint8_t)index;
             }
         }
     }
-    for (i = 0; i < fullReconCandidateCount; i++) {
-        if (*(buffer_ptr_array[i]->fast_cost_ptr) < *ref_fast_cost) {
-            *ref_fast_cost = *(buffer_ptr_array[i]->fast_cost_ptr);
-        }
-    }
+    for (i = 0; i < fullReconCandidateCount; i++)
+        *ref_fast_cost = MIN(*ref_fast_cost, fast_cost_array[i]);
 #if USED_NFL_FEATURE_BASED
     for (i = 0; i < MAX_NFL; ++i) {
         sorted_candidate_index_array[i] = best_candidate_index_array[i];
@@ -525,7 +523,7 @@ EbErrorType PreModeDecision(
 
     for (i = 0; i < fullReconCandidateCount - 1; ++i) {
         for (j = i + 1; j < fullReconCandidateCount; ++j) {
-            if (*(buffer_ptr_array[j]->fast_cost_ptr) < *(buffer_ptr_array[i]->fast_cost_ptr)) {
+            if (fast_cost_array[j] < fast_cost_array[i]) {
                 index = sorted_candidate_index_array[i];
                 sorted_candidate_index_array[i] = (uint8_t)sorted_candidate_index_array[j];
                 sorted_candidate_index_array[j] = (uint8_t)index;
@@ -541,7 +539,7 @@ EbErrorType PreModeDecision(
         fullCandidateIndex = best_candidate_index_array[i];
 
         // Set disable_merge_index
-        *disable_merge_index = buffer_ptr_array[fullCandidateIndex]->candidate_ptr->type == INTER_MODE ? 1 : *disable_merge_index;
+        *disable_merge_index = candidate_type_array[fullCandidateIndex] == INTER_MODE ? 1 : *disable_merge_index;
     }
 
     return return_error;
@@ -573,6 +571,9 @@ void Unipred3x3CandidatesInjection(
     ModeDecisionCandidate_t    *candidateArray = context_ptr->fast_candidate_array;
     EbBool isCompoundEnabled = (picture_control_set_ptr->parent_pcs_ptr->reference_mode == SINGLE_REFERENCE) ? 0 : 1;
     IntMv  bestPredmv[2] = { {0}, {0} };
+#if ME_REFERENCE_PRUNING
+    uint8_t me_pruned_list_mask = use_close_loop_me ? 0 : mePuResult->prunedListMask;
+#endif
 
     // (8 Best_L0 neighbors)
     for (bipredIndex = 0; bipredIndex < BIPRED_3x3_REFINMENT_POSITIONS; ++bipredIndex)
@@ -583,7 +584,11 @@ void Unipred3x3CandidatesInjection(
 #if REMOVED_DUPLICATE_INTER
         int16_t to_inject_mv_x = use_close_loop_me ? (inloop_me_context->inloop_me_mv[0][0][close_loop_me_index][0] + BIPRED_3x3_X_POS[bipredIndex]) << 1 : (mePuResult->xMvL0 + BIPRED_3x3_X_POS[bipredIndex]) << 1;
         int16_t to_inject_mv_y = use_close_loop_me ? (inloop_me_context->inloop_me_mv[0][0][close_loop_me_index][1] + BIPRED_3x3_Y_POS[bipredIndex]) << 1 : (mePuResult->yMvL0 + BIPRED_3x3_Y_POS[bipredIndex]) << 1;
+#if ME_REFERENCE_PRUNING
+        if (!(me_pruned_list_mask & (1 << REF_LIST_0)) && (context_ptr->injected_mv_count_l0 == 0 || is_already_injected_mv_l0(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE)) {
+#else
         if (context_ptr->injected_mv_count_l0 == 0 || is_already_injected_mv_l0(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE) {
+#endif
 #endif
             candidateArray[canTotalCnt].type = INTER_MODE;
 #if TWO_FAST_LOOP 
@@ -659,7 +664,11 @@ void Unipred3x3CandidatesInjection(
 #if REMOVED_DUPLICATE_INTER_L1
             int16_t to_inject_mv_x = use_close_loop_me ? (inloop_me_context->inloop_me_mv[1][0][close_loop_me_index][0] + BIPRED_3x3_X_POS[bipredIndex]) << 1 : (mePuResult->xMvL1 + BIPRED_3x3_X_POS[bipredIndex]) << 1;
             int16_t to_inject_mv_y = use_close_loop_me ? (inloop_me_context->inloop_me_mv[1][0][close_loop_me_index][1] + BIPRED_3x3_Y_POS[bipredIndex]) << 1 : (mePuResult->yMvL1 + BIPRED_3x3_Y_POS[bipredIndex]) << 1;
+#if ME_REFERENCE_PRUNING
+            if (!(me_pruned_list_mask & (1 << REF_LIST_1)) && (context_ptr->injected_mv_count_l1 == 0 || is_already_injected_mv_l1(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE)) {
+#else
             if (context_ptr->injected_mv_count_l1 == 0 || is_already_injected_mv_l1(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE) {
+#endif
 #endif
                 candidateArray[canTotalCnt].type = INTER_MODE;
 #if TWO_FAST_LOOP 
@@ -752,6 +761,11 @@ void Bipred3x3CandidatesInjection(
     EbBool isCompoundEnabled = (picture_control_set_ptr->parent_pcs_ptr->reference_mode == SINGLE_REFERENCE) ? 0 : 1;
     IntMv  bestPredmv[2] = { {0}, {0} };
 
+#if ME_REFERENCE_PRUNING
+    // No bi-pred ME candidate when the ME pruned one of the lists
+    if (!use_close_loop_me && mePuResult->prunedListMask)
+        return;
+#endif
     if (isCompoundEnabled) {
         /**************
        NEW_NEWMV
@@ -1486,7 +1500,13 @@ void inject_warped_motion_candidates(
         { 2, -2 }, { 2, 2 }, { 2, 2 }, { -2, 2 } };
 
     IntMv  bestPredmv[2] = { {0}, {0} };
+#if ME_REFERENCE_PRUNING
+    // No ME MV to build the candidates around when L0 was pruned
+    uint8_t me_pruned_list_mask = use_close_loop_me ? 0 : mePuResult->prunedListMask;
+    for (int i = 0; i < 9 && !(me_pruned_list_mask & (1 << REF_LIST_0)); i++) {
+#else
     for (int i=0; i<9; i++){
+#endif
 #if REMOVED_DUPLICATE_INTER
         int16_t to_inject_mv_x = use_close_loop_me ? ss_mecontext->inloop_me_mv[0][0][close_loop_me_index][0] << 1 : mePuResult->xMvL0 << 1; // context_ptr->cu_ptr->ref_mvs[LAST_FRAME][0].as_mv.col;
         int16_t to_inject_mv_y = use_close_loop_me ? ss_mecontext->inloop_me_mv[0][0][close_loop_me_index][1] << 1 : mePuResult->yMvL0 << 1; // context_ptr->cu_ptr->ref_mvs[LAST_FRAME][0].as_mv.row;
@@ -1655,6 +1675,10 @@ void  inject_inter_candidates(
         ((context_ptr->blk_geom->bwidth == 4 || context_ptr->blk_geom->bheight == 4) || (context_ptr->blk_geom->bwidth > 64 || context_ptr->blk_geom->bheight > 64)) ? EB_TRUE : EB_FALSE;
 
     uint32_t close_loop_me_index = use_close_loop_me ? get_in_loop_me_info_index(MAX_SS_ME_PU_COUNT, sequence_control_set_ptr->sb_size == BLOCK_128X128 ? 1 : 0, context_ptr->blk_geom) : 0;
+#if ME_REFERENCE_PRUNING
+    // Lists dropped by the ME reference pruning have no ME MV: skip their NEWMV candidates
+    uint8_t me_pruned_list_mask = use_close_loop_me ? 0 : mePuResult->prunedListMask;
+#endif
 #if BASE_LAYER_REF
     EbBool allow_bipred = (picture_control_set_ptr->parent_pcs_ptr->temporal_layer_index == 0 || context_ptr->blk_geom->bwidth == 4 || context_ptr->blk_geom->bheight == 4) ? EB_FALSE : EB_TRUE;
 #else    
@@ -1715,7 +1739,11 @@ void  inject_inter_candidates(
 #if REMOVED_DUPLICATE_INTER
         int16_t to_inject_mv_x = use_close_loop_me ? ss_mecontext->inloop_me_mv[0][0][close_loop_me_index][0] << 1 : mePuResult->xMvL0 << 1;
         int16_t to_inject_mv_y = use_close_loop_me ? ss_mecontext->inloop_me_mv[0][0][close_loop_me_index][1] << 1 : mePuResult->yMvL0 << 1;
+#if ME_REFERENCE_PRUNING
+        if (!(me_pruned_list_mask & (1 << REF_LIST_0)) && (context_ptr->injected_mv_count_l0 == 0 || is_already_injected_mv_l0(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE)) {
+#else
         if (context_ptr->injected_mv_count_l0 == 0 || is_already_injected_mv_l0(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE) {
+#endif
 #endif
         candidateArray[canTotalCnt].type = INTER_MODE;
 #if TWO_FAST_LOOP 
@@ -1786,7 +1814,11 @@ void  inject_inter_candidates(
 #if REMOVED_DUPLICATE_INTER_L1
             int16_t to_inject_mv_x = use_close_loop_me ? ss_mecontext->inloop_me_mv[1][0][close_loop_me_index][0] << 1 : mePuResult->xMvL1 << 1;
             int16_t to_inject_mv_y = use_close_loop_me ? ss_mecontext->inloop_me_mv[1][0][close_loop_me_index][1] << 1 : mePuResult->yMvL1 << 1;
+#if ME_REFERENCE_PRUNING
+            if (!(me_pruned_list_mask & (1 << REF_LIST_1)) && (context_ptr->injected_mv_count_l1 == 0 || is_already_injected_mv_l1(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE)) {
+#else
             if (context_ptr->injected_mv_count_l1 == 0 || is_already_injected_mv_l1(context_ptr, to_inject_mv_x, to_inject_mv_y) == EB_FALSE) {
+#endif
 #endif
             candidateArray[canTotalCnt].type = INTER_MODE;
 #if TWO_FAST_LOOP 
@@ -1860,7 +1892,11 @@ void  inject_inter_candidates(
                 int16_t to_inject_mv_y_l0 = use_close_loop_me ? ss_mecontext->inloop_me_mv[0][0][close_loop_me_index][1] << 1 : mePuResult->yMvL0 << 1;
                 int16_t to_inject_mv_x_l1 = use_close_loop_me ? ss_mecontext->inloop_me_mv[1][0][close_loop_me_index][0] << 1 : mePuResult->xMvL1 << 1;
                 int16_t to_inject_mv_y_l1 = use_close_loop_me ? ss_mecontext->inloop_me_mv[1][0][close_loop_me_index][1] << 1 : mePuResult->yMvL1 << 1;
+#if ME_REFERENCE_PRUNING
+                if (!me_pruned_list_mask && (context_ptr->injected_mv_count_bipred == 0 || is_already_injected_mv_bipred(context_ptr, to_inject_mv_x_l0, to_inject_mv_y_l0, to_inject_mv_x_l1, to_inject_mv_y_l1) == EB_FALSE)) {
+#else
                 if (context_ptr->injected_mv_count_bipred == 0 || is_already_injected_mv_bipred(context_ptr, to_inject_mv_x_l0, to_inject_mv_y_l0, to_inject_mv_x_l1, to_inject_mv_y_l1) == EB_FALSE) {
+#endif
 #endif
                 candidateArray[canTotalCnt].type = INTER_MODE;
 #if TWO_FAST_LOOP 
@@ -2309,6 +2345,64 @@ static INLINE TxType av1_get_tx_type(
 }
 
 
+#if OIS_MD_INTRA_PRUNING
+/***************************************
+* Direction, in degrees, of the best angular open loop intra search
+* candidate of the square block holding the MD block; -1 when OIS has
+* no angular candidate there (not searched, DC only, 64x64 and above)
+***************************************/
+static int32_t get_ois_best_angle(
+    PictureControlSet_t            *picture_control_set_ptr,
+    ModeDecisionContext_t          *context_ptr,
+    const SequenceControlSet_t     *sequence_control_set_ptr,
+    LargestCodingUnit_t            *sb_ptr)
+{
+    PictureParentControlSet_t  *parent_pcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
+    uint32_t                    cu_size = MAX(8, context_ptr->blk_geom->sq_size);
+    uint32_t                    block_x = sb_ptr->origin_x + context_ptr->blk_geom->origin_x;
+    uint32_t                    block_y = sb_ptr->origin_y + context_ptr->blk_geom->origin_y;
+    // Same 64x64 SB grid as the ME kernel, whatever the MD SB size
+    uint32_t                    picture_width_in_sb = (sequence_control_set_ptr->luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+    uint32_t                    sb_index;
+    uint32_t                    raster_scan_cu_index;
+    uint32_t                    cu_x;
+    uint32_t                    cu_y;
+    uint8_t                     total_intra_luma_mode;
+    OisCandidate_t             *ois_cu_ptr;
+    uint8_t                     candidate_index;
+
+    if (cu_size > 32)
+        return -1;
+
+    // OIS runs on 64x64 SBs, in raster scan CU order
+    sb_index = (block_x / BLOCK_SIZE_64) + (block_y / BLOCK_SIZE_64) * picture_width_in_sb;
+    if (sb_index >= parent_pcs_ptr->sb_total_count)
+        return -1;
+    cu_x = (block_x % BLOCK_SIZE_64) / cu_size;
+    cu_y = (block_y % BLOCK_SIZE_64) / cu_size;
+    raster_scan_cu_index = (cu_size == 32 ? RASTER_SCAN_CU_INDEX_32x32_0 : cu_size == 16 ? RASTER_SCAN_CU_INDEX_16x16_0 : RASTER_SCAN_CU_INDEX_8x8_0) +
+        cu_y * (BLOCK_SIZE_64 / cu_size) + cu_x;
+
+    if (raster_scan_cu_index < RASTER_SCAN_CU_INDEX_8x8_0) {
+        total_intra_luma_mode = parent_pcs_ptr->ois_cu32_cu16_results[sb_index]->total_intra_luma_mode[raster_scan_cu_index];
+        ois_cu_ptr = parent_pcs_ptr->ois_cu32_cu16_results[sb_index]->sorted_ois_candidate[raster_scan_cu_index];
+    }
+    else {
+        total_intra_luma_mode = parent_pcs_ptr->ois_cu8_results[sb_index]->total_intra_luma_mode[raster_scan_cu_index - RASTER_SCAN_CU_INDEX_8x8_0];
+        ois_cu_ptr = parent_pcs_ptr->ois_cu8_results[sb_index]->sorted_ois_candidate[raster_scan_cu_index - RASTER_SCAN_CU_INDEX_8x8_0];
+    }
+
+    // The candidates are ranked: the first angular one is the best direction
+    for (candidate_index = 0; candidate_index < MIN(total_intra_luma_mode, MAX_OPEN_LOOP_INTRA_CANDIDATES); candidate_index++) {
+        uint32_t ois_mode = ois_cu_ptr[candidate_index].intra_mode;
+        if (ois_mode > EB_INTRA_DC && ois_mode < MAX_INTRA_MODES)
+            return (int32_t)mode_to_angle_map[intra_hev_cmode_to_intra_av1_mode[ois_mode]] + hevcMode_to_angle_delta_map[ois_mode] * ANGLE_STEP;
+    }
+
+    return -1;
+}
+#endif
+
 // END of Function Declarations
 void  inject_intra_candidates(
     PictureControlSet_t            *picture_control_set_ptr,
@@ -2389,6 +2483,12 @@ void  inject_intra_candidates(
 #endif
 #if !DIS_EDGE_FIL
     const int32_t disable_ang_uv = (context_ptr->blk_geom->bwidth == 4 || context_ptr->blk_geom->bheight == 4) && context_ptr->blk_geom->has_uv ? 1 : 0;
+#endif
+#if OIS_MD_INTRA_PRUNING
+    // Directional candidates far from the OIS best direction are neither predicted nor costed
+    const int32_t ois_best_angle = picture_control_set_ptr->parent_pcs_ptr->ois_intra_pruning_level ?
+        get_ois_best_angle(picture_control_set_ptr, context_ptr, sequence_control_set_ptr, sb_ptr) : -1;
+    const int32_t ois_max_angle_distance = picture_control_set_ptr->parent_pcs_ptr->ois_intra_pruning_level == 1 ? 45 : 22;
 #endif
     for (openLoopIntraCandidate = intra_mode_start; openLoopIntraCandidate < intra_mode_end + 1; ++openLoopIntraCandidate) {
 
@@ -2398,6 +2498,10 @@ void  inject_intra_candidates(
                 for (angleDeltaCounter = 0; angleDeltaCounter < angleDeltaCandidateCount; ++angleDeltaCounter) {
                     int32_t angle_delta = angleDeltaCandidateCount == 1 ? 0 : angleDeltaCounter - (angleDeltaCandidateCount >> 1);
                     int32_t  p_angle = mode_to_angle_map[(PredictionMode)openLoopIntraCandidate] + angle_delta * ANGLE_STEP;
+#if OIS_MD_INTRA_PRUNING
+                    if (ois_best_angle >= 0 && ABS(p_angle - ois_best_angle) > ois_max_angle_distance)
+                        continue;
+#endif
                     if (!disable_z2_prediction || (p_angle <= 90 || p_angle >= 180)) {
                         candidateArray[canTotalCnt].type = INTRA_MODE;
                         candidateArray[canTotalCnt].intra_luma_mode = openLoopIntraCandidate;
@@ -2642,6 +2746,9 @@ uint8_t product_full_mode_decision(
     PredictionUnit_t       *pu_ptr;
     uint32_t                   i;
     ModeDecisionCandidate_t       *candidate_ptr;
+    // buffer_ptr_array starts at the candidate buffers of the current depth
+    const uint64_t            *full_cost_array = context_ptr->full_cost_array + context_ptr->buffer_depth_index_start[0];
+    const uint8_t             *candidate_type_array = context_ptr->candidate_type_array + context_ptr->buffer_depth_index_start[0];
 
     lowestCostIndex = best_candidate_index_array[0];
 
@@ -2650,14 +2757,14 @@ uint8_t product_full_mode_decision(
         candidateIndex = best_candidate_index_array[i];
 
         // Compute fullCostBis
-        if ((*(buffer_ptr_array[candidateIndex]->full_cost_ptr) < lowestIntraCost) && buffer_ptr_array[candidateIndex]->candidate_ptr->type == INTRA_MODE) {
+        if ((full_cost_array[candidateIndex] < lowestIntraCost) && candidate_type_array[candidateIndex] == INTRA_MODE) {
             *best_intra_mode = buffer_ptr_array[candidateIndex]->candidate_ptr->pred_mode;
-            lowestIntraCost = *(buffer_ptr_array[candidateIndex]->full_cost_ptr);
+            lowestIntraCost = full_cost_array[candidateIndex];
         }
 
-        if (*(buffer_ptr_array[candidateIndex]->full_cost_ptr) < lowestCost) {
+        if (full_cost_array[candidateIndex] < lowestCost) {
             lowestCostIndex = candidateIndex;
-            lowestCost = *(buffer_ptr_array[candidateIndex]->full_cost_ptr);
+            lowestCost = full_cost_array[candidateIndex];
         }
     }
 
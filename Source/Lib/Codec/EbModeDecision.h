@@ -398,7 +398,8 @@ extern "C" {
     EbErrorType PreModeDecision(
         CodingUnit_t                   *cu_ptr,
         uint32_t                        buffer_total_count,
-        ModeDecisionCandidateBuffer_t **buffer_ptr_array,
+        const uint64_t                 *fast_cost_array,
+        const uint8_t                  *candidate_type_array,
         uint32_t                       *full_candidate_total_count_ptr,
         uint8_t                        *best_candidate_index_array,
 #if USED_NFL_FEATURE_BASED
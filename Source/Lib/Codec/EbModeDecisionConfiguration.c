@@ -1134,9 +1134,17 @@ void PredictionPartitionLoop(
                     context_ptr->mdc_candidate_ptr->merge_flag = EB_FALSE;
                     context_ptr->mdc_candidate_ptr->merge_index = 0;
 #if MDC_FIX_1
+#if ME_REFERENCE_PRUNING
+                    // A pruned L0 has no MV of its own, the ME best direction is used instead
+                    context_ptr->mdc_candidate_ptr->prediction_direction[0] = (picture_control_set_ptr->parent_pcs_ptr->temporal_layer_index == 0 &&
+                        !(mePuResult->prunedListMask & (1 << REF_LIST_0))) ?
+                        UNI_PRED_LIST_0 :
+                        mePuResult->distortionDirection[0].direction;
+#else
                     context_ptr->mdc_candidate_ptr->prediction_direction[0] = (picture_control_set_ptr->parent_pcs_ptr->temporal_layer_index == 0) ?
                         UNI_PRED_LIST_0 :
                         mePuResult->distortionDirection[0].direction;
+#endif
 #else
                     context_ptr->mdc_candidate_ptr->prediction_direction[0] = UNI_PRED_LIST_0;
 #endif
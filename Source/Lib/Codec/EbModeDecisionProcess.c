@@ -30,6 +30,18 @@ EbErrorType mode_decision_context_ctor(
     context_ptr->mode_decision_configuration_input_fifo_ptr = mode_decision_configuration_input_fifo_ptr;
     context_ptr->mode_decision_output_fifo_ptr = mode_decision_output_fifo_ptr;
 
+    context_ptr->interp_search_pred_count = 0;
+    context_ptr->interp_search_pred_saved_count = 0;
+    context_ptr->tx_search_type_count = 0;
+    context_ptr->tx_search_type_pruned_count = 0;
+    EB_MEMSET(context_ptr->intra_edge_cache, 0, sizeof(context_ptr->intra_edge_cache));
+#if MD_PROFILER
+    EB_MEMSET(&context_ptr->md_profiler, 0, sizeof(context_ptr->md_profiler));
+#endif
+
+    // SB-local neighbor stash
+    EB_MALLOC(uint8_t*, context_ptr->md_neighbor_stash, MD_NEIGHBOR_STASH_SIZE, EB_N_PTR);
+
     // Trasform Scratch Memory
     EB_MALLOC(int16_t*, context_ptr->transform_inner_array_ptr, 3120, EB_N_PTR); //refer to EbInvTransform_SSE2.as. case 32x32
 
@@ -61,6 +73,8 @@ EbErrorType mode_decision_context_ctor(
 
     EB_MALLOC(uint64_t*, context_ptr->full_cost_array, sizeof(uint64_t) * MODE_DECISION_CANDIDATE_BUFFER_MAX_COUNT, EB_N_PTR);
 
+    EB_MALLOC(uint8_t*, context_ptr->candidate_type_array, sizeof(uint8_t) * MODE_DECISION_CANDIDATE_BUFFER_MAX_COUNT, EB_N_PTR);
+
     EB_MALLOC(uint64_t*, context_ptr->full_cost_skip_ptr, sizeof(uint64_t) * MODE_DECISION_CANDIDATE_BUFFER_MAX_COUNT, EB_N_PTR);
 
     EB_MALLOC(uint64_t*, context_ptr->full_cost_merge_ptr, sizeof(uint64_t) * MODE_DECISION_CANDIDATE_BUFFER_MAX_COUNT, EB_N_PTR);
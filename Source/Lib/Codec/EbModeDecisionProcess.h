@@ -16,6 +16,7 @@
 #include "EbTransQuantBuffers.h"
 #include "EbReferenceObject.h"
 #include "EbNeighborArrays.h"
+#include "EbMdProfiler.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +37,15 @@ extern "C" {
 
 #define INDEPENDENT_INTRA_CHROMA_MODE_TOTAL_COUNT       4       // Planar, Vertical, Horizontal, DC
 
+// SB-local neighbor stash: up to 16 MD neighbor arrays, each saving top, left and
+// top-left spans of at most (4 x MAX_SB_SIZE) units of at most 4 bytes
+#define MD_NEIGHBOR_STASH_SIZE                          (16 * 4 * MAX_SB_SIZE * sizeof(uint32_t))
+
+// Intra edge cache: edge buffers are sized as the local edges of the intra
+// predictors, filtered variants are replaced in round robin once all are used
+#define INTRA_EDGE_BUFFER_SIZE                          (MAX_TX_SIZE * 2 + 32)
+#define INTRA_EDGE_CACHE_VARIANTS                       16
+
 #define DEPTH_ONE_STEP   21
 #define DEPTH_TWO_STEP    5
 #define DEPTH_THREE_STEP  1
@@ -64,6 +74,41 @@ extern "C" {
 
     } MdEncPassCuData_t;
 
+    /**************************************
+     * Intra edge cache
+     **************************************/
+    typedef struct IntraEdge_s
+    {
+        uint64_t                    key;           // edge filter and upsampling settings, 0 for the unfiltered edges
+        DECLARE_ALIGNED(16, uint8_t, above_data[INTRA_EDGE_BUFFER_SIZE]);
+        DECLARE_ALIGNED(16, uint8_t, left_data[INTRA_EDGE_BUFFER_SIZE]);
+    } IntraEdge_t;
+
+    // Above and left reference samples of the block being evaluated by MD, for one
+    // plane. The unfiltered edges are built once per block, extended for all the
+    // modes, and the filtered edges once per edge filter setting. Invalidated at
+    // the start of each block, and rebuilt when the transform size or the number
+    // of available neighbors changes.
+    typedef struct IntraEdgeCache_s
+    {
+        EbBool                      valid;
+        TxSize                      tx_size;
+        int32_t                     n_top_px;
+        int32_t                     n_topright_px;
+        int32_t                     n_left_px;
+        int32_t                     n_bottomleft_px;
+        IntraEdge_t                 base;
+        uint32_t                    variant_count;
+        uint32_t                    variant_next;
+        IntraEdge_t                 variant[INTRA_EDGE_CACHE_VARIANTS];
+
+        // Statistics: edges built and edges reused, unfiltered and filtered
+        uint64_t                    base_build_count;
+        uint64_t                    base_reuse_count;
+        uint64_t                    variant_build_count;
+        uint64_t                    variant_reuse_count;
+    } IntraEdgeCache_t;
+
 
     typedef struct MdCodingUnit_s
     {
@@ -128,8 +173,13 @@ extern "C" {
         EbTransQuantBuffers_t          *trans_quant_buffers_ptr;
         struct EncDecContext_s         *enc_dec_context_ptr;
 
+        // Costs and types of the candidate buffers in structure of arrays layout,
+        // indexed as candidate_buffer_ptr_array, for the candidate selection. The
+        // modes, MVs and references stay in ModeDecisionCandidate_t, and the fast
+        // costs are still evaluated one candidate at a time
         uint64_t                       *fast_cost_array;
         uint64_t                       *full_cost_array;
+        uint8_t                        *candidate_type_array;
         uint64_t                       *full_cost_skip_ptr;
         uint64_t                       *full_cost_merge_ptr;
 
@@ -207,6 +257,7 @@ extern "C" {
         uint8_t                         intra_chroma_left_mode;
         uint8_t                         intra_chroma_top_mode;
         int16_t                         pred_buf_q3[CFL_BUF_SQUARE]; // Hsan: both MD and EP to use pred_buf_q3 (kept 1, and removed the 2nd)
+        IntraEdgeCache_t                intra_edge_cache[MAX_MB_PLANE];
 #if INTRA_CORE_OPT
         DECLARE_ALIGNED(16, uint8_t, left_data[MAX_MB_PLANE][MAX_TX_SIZE * 2 + 32]);
         DECLARE_ALIGNED(16, uint8_t, above_data[MAX_MB_PLANE][MAX_TX_SIZE * 2 + 32]);
@@ -232,6 +283,19 @@ extern "C" {
         // Multi-modes signal(s) 
         uint8_t                           nfl_level;
         uint8_t                           skip_interpolation_search;
+        // Interpolation filter search statistics: predictions performed and
+        // predictions saved by the full-pel reuse and the pruning
+        uint64_t                          interp_search_pred_count;
+        uint64_t                          interp_search_pred_saved_count;
+        // Tx type search statistics: tx types evaluated and pruned
+        uint64_t                          tx_search_type_count;
+        uint64_t                          tx_search_type_pruned_count;
+#if MD_PROFILER
+        MdProfiler_t                      md_profiler;
+#endif
+        // SB-local copy of the neighbor spans of the square block whose
+        // non-square shapes are being evaluated
+        uint8_t                          *md_neighbor_stash;
         uint8_t                           parent_sq_type[MAX_PARENT_SQ];
         uint8_t                           parent_sq_has_coeff[MAX_PARENT_SQ];
         uint8_t                           parent_sq_pred_mode[MAX_PARENT_SQ];
@@ -6205,6 +6205,18 @@ EbErrorType MotionEstimateLcu(
     EbBool                    enableHalfPel8x8 = EB_FALSE;
     EbBool                    enableQuarterPel = EB_FALSE;
     EbBool                 oneQuadrantHME =  EB_FALSE;
+#if ADAPTIVE_ME_SEARCH_AREA || ME_REFERENCE_PRUNING
+    EbBool                 hmeLevel0AllRegionsFlag;
+#endif
+#if ME_REFERENCE_PRUNING
+    // HME result of each list, kept for the full-pel and sub-pel pass
+    int16_t                listSearchCenterX[MAX_NUM_OF_REF_PIC_LIST];
+    int16_t                listSearchCenterY[MAX_NUM_OF_REF_PIC_LIST];
+    int16_t                listSearchAreaWidth[MAX_NUM_OF_REF_PIC_LIST];
+    int16_t                listSearchAreaHeight[MAX_NUM_OF_REF_PIC_LIST];
+    uint64_t               listHmeLevel0Sad[MAX_NUM_OF_REF_PIC_LIST];
+    uint8_t                prunedListMask = 0;
+#endif
 
 #if M0_SAD_HALF_QUARTER_PEL_BIPRED_SEARCH || M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
 #if M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
@@ -6231,12 +6243,19 @@ EbErrorType MotionEstimateLcu(
         ref1Poc = picture_control_set_ptr->ref_pic_poc_array[1];
     }
 
+#if ADAPTIVE_ME_SEARCH_AREA
+    context_ptr->searched_sb_count++;
+#endif
+
     // Uni-Prediction motion estimation loop
     // List Loop
     for (listIndex = REF_LIST_0; listIndex <= numOfListToSearch; ++listIndex) {
 
         // Ref Picture Loop
         {
+#if ADAPTIVE_ME_SEARCH_AREA || ME_REFERENCE_PRUNING
+            hmeLevel0AllRegionsFlag = EB_FALSE;
+#endif
 
             referenceObject = (EbPaReferenceObject_t*)picture_control_set_ptr->ref_pa_pic_ptr_array[listIndex]->object_ptr;
             refPicPtr = (EbPictureBufferDesc_t*)referenceObject->inputPaddedPicturePtr;
@@ -6351,6 +6370,9 @@ EbErrorType MotionEstimateLcu(
                                     searchRegionNumberInWidth = 0;
                                     searchRegionNumberInHeight++;
                                 }
+#if ADAPTIVE_ME_SEARCH_AREA || ME_REFERENCE_PRUNING
+                                hmeLevel0AllRegionsFlag = EB_TRUE;
+#endif
                                     }
                                 }
                             }
@@ -6543,6 +6565,71 @@ EbErrorType MotionEstimateLcu(
             }
             search_area_width = (int16_t)MIN(context_ptr->search_area_width, 127);
             search_area_height = (int16_t)MIN(context_ptr->search_area_height, 127);
+#if ADAPTIVE_ME_SEARCH_AREA
+            // Narrow the search area of the SB when its HME level 0 search regions agree on the motion
+            if (context_ptr->adaptive_search_area_flag && hmeLevel0AllRegionsFlag) {
+                int16_t  xSpreadMin = xHmeLevel0SearchCenter[0][0];
+                int16_t  xSpreadMax = xSpreadMin;
+                int16_t  ySpreadMin = yHmeLevel0SearchCenter[0][0];
+                int16_t  ySpreadMax = ySpreadMin;
+                uint32_t regionX, regionY;
+
+                for (regionY = 0; regionY < context_ptr->number_hme_search_region_in_height; ++regionY) {
+                    for (regionX = 0; regionX < context_ptr->number_hme_search_region_in_width; ++regionX) {
+                        xSpreadMin = MIN(xSpreadMin, xHmeLevel0SearchCenter[regionX][regionY]);
+                        xSpreadMax = MAX(xSpreadMax, xHmeLevel0SearchCenter[regionX][regionY]);
+                        ySpreadMin = MIN(ySpreadMin, yHmeLevel0SearchCenter[regionX][regionY]);
+                        ySpreadMax = MAX(ySpreadMax, yHmeLevel0SearchCenter[regionX][regionY]);
+                    }
+                }
+                search_area_width = (int16_t)MIN(search_area_width, MAX(ADAPTIVE_SEARCH_AREA_MIN, 2 * (xSpreadMax - xSpreadMin) + ADAPTIVE_SEARCH_AREA_MARGIN));
+                search_area_height = (int16_t)MIN(search_area_height, MAX(ADAPTIVE_SEARCH_AREA_MIN, 2 * (ySpreadMax - ySpreadMin) + ADAPTIVE_SEARCH_AREA_MARGIN));
+            }
+#endif
+#if ME_REFERENCE_PRUNING
+            listSearchCenterX[listIndex] = x_search_center;
+            listSearchCenterY[listIndex] = y_search_center;
+            listSearchAreaWidth[listIndex] = search_area_width;
+            listSearchAreaHeight[listIndex] = search_area_height;
+            listHmeLevel0Sad[listIndex] = (uint64_t)~0;
+            if (hmeLevel0AllRegionsFlag) {
+                uint32_t regionX, regionY;
+
+                for (regionY = 0; regionY < context_ptr->number_hme_search_region_in_height; ++regionY)
+                    for (regionX = 0; regionX < context_ptr->number_hme_search_region_in_width; ++regionX)
+                        listHmeLevel0Sad[listIndex] = MIN(listHmeLevel0Sad[listIndex], hmeLevel0Sad[regionX][regionY]);
+            }
+        }
+    }
+
+    // Reference pruning: drop the list whose HME level 0 SAD is well above the SAD of the other list,
+    // with a looser threshold for the temporally closer reference
+    if (picture_control_set_ptr->me_reference_pruning_level && numOfListToSearch && ref0Poc != ref1Poc &&
+        listHmeLevel0Sad[REF_LIST_0] != (uint64_t)~0 && listHmeLevel0Sad[REF_LIST_1] != (uint64_t)~0) {
+
+        uint64_t threshold = picture_control_set_ptr->me_reference_pruning_level == 1 ? 50 : 25;
+        uint64_t distance0 = (uint64_t)ABS((int64_t)picture_control_set_ptr->picture_number - (int64_t)ref0Poc);
+        uint64_t distance1 = (uint64_t)ABS((int64_t)picture_control_set_ptr->picture_number - (int64_t)ref1Poc);
+
+        if (listHmeLevel0Sad[REF_LIST_0] * 100 > listHmeLevel0Sad[REF_LIST_1] * (100 + (distance0 < distance1 ? 2 * threshold : threshold)))
+            prunedListMask = 1 << REF_LIST_0;
+        else if (listHmeLevel0Sad[REF_LIST_1] * 100 > listHmeLevel0Sad[REF_LIST_0] * (100 + (distance1 < distance0 ? 2 * threshold : threshold)))
+            prunedListMask = 1 << REF_LIST_1;
+    }
+
+    // Full-pel and sub-pel search of the remaining lists
+    for (listIndex = REF_LIST_0; listIndex <= numOfListToSearch; ++listIndex) {
+
+        if (prunedListMask & (1 << listIndex))
+            continue;
+        {
+            referenceObject = (EbPaReferenceObject_t*)picture_control_set_ptr->ref_pa_pic_ptr_array[listIndex]->object_ptr;
+            refPicPtr = (EbPictureBufferDesc_t*)referenceObject->inputPaddedPicturePtr;
+            x_search_center = listSearchCenterX[listIndex];
+            y_search_center = listSearchCenterY[listIndex];
+            search_area_width = listSearchAreaWidth[listIndex];
+            search_area_height = listSearchAreaHeight[listIndex];
+#endif
     
             if ((x_search_center != 0 || y_search_center != 0) && (picture_control_set_ptr->is_used_as_reference_flag == EB_TRUE)) {
                 CheckZeroZeroCenter(
@@ -6616,6 +6703,10 @@ EbErrorType MotionEstimateLcu(
 
             context_ptr->x_search_area_origin[listIndex][0] = x_search_area_origin;
             context_ptr->y_search_area_origin[listIndex][0] = y_search_area_origin;
+#if ADAPTIVE_ME_SEARCH_AREA
+            context_ptr->searched_area_sum += (uint64_t)search_area_width * search_area_height;
+            context_ptr->default_search_area_sum += (uint64_t)MIN(context_ptr->default_search_area_width, 127) * MIN(context_ptr->default_search_area_height, 127);
+#endif
 
             xTopLeftSearchRegion = (int16_t)(refPicPtr->origin_x + sb_origin_x) - (ME_FILTER_TAP >> 1) + x_search_area_origin;
             yTopLeftSearchRegion = (int16_t)(refPicPtr->origin_y + sb_origin_y) - (ME_FILTER_TAP >> 1) + y_search_area_origin;
@@ -6881,13 +6972,21 @@ EbErrorType MotionEstimateLcu(
 
 
         for (listIndex = REF_LIST_0; listIndex <= numOfListToSearch; ++listIndex) {
+#if ME_REFERENCE_PRUNING
+            if (prunedListMask & (1 << listIndex))
+                continue;
+#endif
             candidateIndex++;
         }
 
 
         totalMeCandidateIndex = candidateIndex;
 
+#if ME_REFERENCE_PRUNING
+        if (numOfListToSearch && !prunedListMask) {
+#else
         if (numOfListToSearch) {
+#endif
 #if DISABLE_NSQ_FOR_NON_REF || DISABLE_NSQ
             if (picture_control_set_ptr->cu8x8_mode == CU_8x8_MODE_0 || pu_index < 21 || (picture_control_set_ptr->pic_depth_mode <= PIC_ALL_C_DEPTH_MODE)) {
 #else
@@ -6907,6 +7006,9 @@ EbErrorType MotionEstimateLcu(
 
         MeCuResults_t * mePuResult = &picture_control_set_ptr->me_results[sb_index][pu_index];
         mePuResult->totalMeCandidateIndex = totalMeCandidateIndex;
+#if ME_REFERENCE_PRUNING
+        mePuResult->prunedListMask = prunedListMask;
+#endif
 
         if (totalMeCandidateIndex == 3) {
 
@@ -6994,12 +7096,36 @@ EbErrorType MotionEstimateLcu(
             }
 
         }
+#if ME_REFERENCE_PRUNING
+        else if (prunedListMask & (1 << REF_LIST_0)) {
+            // Not searched: the MV of the surviving list stands in for the
+            // consumers that take the ME MVs as search centers
+            uint32_t L1Sad = context_ptr->p_sb_best_sad[1][0][nIdx];
+            mePuResult->xMvL1 = _MVXT(context_ptr->p_sb_best_mv[1][0][nIdx]);
+            mePuResult->yMvL1 = _MVYT(context_ptr->p_sb_best_mv[1][0][nIdx]);
+            mePuResult->xMvL0 = mePuResult->xMvL1;
+            mePuResult->yMvL0 = mePuResult->yMvL1;
+            NSET_CAND(mePuResult, 0, L1Sad, UNI_PRED_LIST_1)
+        }
+#endif
         else {
             uint32_t L0Sad = context_ptr->p_sb_best_sad[0][0][nIdx];
             mePuResult->xMvL0 = _MVXT(context_ptr->p_sb_best_mv[0][0][nIdx]);
             mePuResult->yMvL0 = _MVYT(context_ptr->p_sb_best_mv[0][0][nIdx]);
+#if ME_REFERENCE_PRUNING
+            if (prunedListMask & (1 << REF_LIST_1)) {
+                // Not searched, p_sb_best_mv[1] is stale: the L0 MV stands in
+                mePuResult->xMvL1 = mePuResult->xMvL0;
+                mePuResult->yMvL1 = mePuResult->yMvL0;
+            }
+            else {
+                mePuResult->xMvL1 = _MVXT(context_ptr->p_sb_best_mv[1][0][nIdx]);
+                mePuResult->yMvL1 = _MVYT(context_ptr->p_sb_best_mv[1][0][nIdx]);
+            }
+#else
             mePuResult->xMvL1 = _MVXT(context_ptr->p_sb_best_mv[1][0][nIdx]);
             mePuResult->yMvL1 = _MVYT(context_ptr->p_sb_best_mv[1][0][nIdx]);
+#endif
             NSET_CAND(mePuResult, 0, L0Sad, UNI_PRED_LIST_0)
         }
 
@@ -7008,7 +7134,7 @@ EbErrorType MotionEstimateLcu(
 
 
 
-    if (sequence_control_set_ptr->static_config.rate_control_mode) {
+    if (sequence_control_set_ptr->static_config.rate_control_mode || sequence_control_set_ptr->static_config.pass == 1) {
 
         // Compute the sum of the distortion of all 16 16x16 (best) blocks in the LCU
         picture_control_set_ptr->rc_me_distortion[sb_index] = 0;
@@ -7885,6 +8011,13 @@ EbErrorType OpenLoopIntraSearchLcu(
             // Init Valid Distortion to EB_FALSE
             InitValidDistortion(
                 OisCuPtr);
+#if OIS_MD_INTRA_PRUNING
+            // No OIS result until the block is searched (read by MD)
+            if (rasterScanCuIndex < RASTER_SCAN_CU_INDEX_8x8_0)
+                oisCu32Cu16ResultsPtr->total_intra_luma_mode[rasterScanCuIndex] = 0;
+            else
+                oisCu8ResultsPtr->total_intra_luma_mode[rasterScanCuIndex - RASTER_SCAN_CU_INDEX_8x8_0] = 0;
+#endif
 
             if (sb_params->raster_scan_cu_validity[rasterScanCuIndex]) {
 
@@ -7920,6 +8053,9 @@ EbErrorType OpenLoopIntraSearchLcu(
 
                     OisCuPtr[0].intra_mode = EB_INTRA_PLANAR;
                     OisCuPtr[0].valid_distortion = EB_TRUE;
+#if OIS_MD_INTRA_PRUNING
+                    oisCu32Cu16ResultsPtr->total_intra_luma_mode[rasterScanCuIndex] = 1;
+#endif
 
                 }
                 else {
@@ -7978,6 +8114,13 @@ EbErrorType OpenLoopIntraSearchLcu(
             // Init Valid Distortion to EB_FALSE
             InitValidDistortion(
                 OisCuPtr);
+#if OIS_MD_INTRA_PRUNING
+            // No OIS result until the block is searched (read by MD)
+            if (rasterScanCuIndex < RASTER_SCAN_CU_INDEX_8x8_0)
+                oisCu32Cu16ResultsPtr->total_intra_luma_mode[rasterScanCuIndex] = 0;
+            else
+                oisCu8ResultsPtr->total_intra_luma_mode[rasterScanCuIndex - RASTER_SCAN_CU_INDEX_8x8_0] = 0;
+#endif
             if (sb_params->raster_scan_cu_validity[rasterScanCuIndex] && !((picture_control_set_ptr->cu8x8_mode == CU_8x8_MODE_1) && cu_size == 8)) {
                 cu_origin_x = sb_params->origin_x + RASTER_SCAN_CU_X[rasterScanCuIndex];
                 cu_origin_y = sb_params->origin_y + RASTER_SCAN_CU_Y[rasterScanCuIndex];
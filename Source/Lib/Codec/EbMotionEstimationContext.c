@@ -47,6 +47,12 @@ EbErrorType MeContextCtor(
 
     (*object_dbl_ptr)->interpolated_stride = MAX_SEARCH_AREA_WIDTH;
 
+#if ADAPTIVE_ME_SEARCH_AREA
+    (*object_dbl_ptr)->searched_area_sum = 0;
+    (*object_dbl_ptr)->default_search_area_sum = 0;
+    (*object_dbl_ptr)->searched_sb_count = 0;
+#endif
+
     EB_MEMSET((*object_dbl_ptr)->sb_buffer, 0, sizeof(uint8_t) * BLOCK_SIZE_64 * (*object_dbl_ptr)->sb_buffer_stride);
     EB_MALLOC(EB_BitFraction *, (*object_dbl_ptr)->mvd_bits_array, sizeof(EB_BitFraction) * NUMBER_OF_MVD_CASES, EB_N_PTR);
     // 15 intermediate buffers to retain the interpolated reference samples
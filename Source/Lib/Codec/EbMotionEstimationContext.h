@@ -16,6 +16,10 @@ extern "C" {
     // Max Search Area
 #define MAX_SEARCH_AREA_WIDTH       1350 // This should be a function for the MAX HME L0 * the multiplications per layers and per Hierarchichal structures
 #define MAX_SEARCH_AREA_HEIGHT      675 // This should be a function for the MAX HME L0 * the multiplications per layers and per Hierarchichal structures
+#if ADAPTIVE_ME_SEARCH_AREA
+#define ADAPTIVE_SEARCH_AREA_MIN    16  // Smallest adaptive search area width / height
+#define ADAPTIVE_SEARCH_AREA_MARGIN 8   // Added to twice the motion range / HME level 0 spread
+#endif
 
 // 1-D interpolation shift value
 #define IFShift                     6
@@ -413,6 +417,15 @@ extern "C" {
         uint16_t                      hme_level2_search_area_in_width_array[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT];
         uint16_t                      hme_level2_search_area_in_height_array[EB_HME_SEARCH_AREA_ROW_MAX_COUNT];
         uint8_t                       update_hme_search_center_flag;
+#if ADAPTIVE_ME_SEARCH_AREA
+        // Search area of the static tables, and searched area counters
+        EbBool                        adaptive_search_area_flag;
+        uint8_t                       default_search_area_width;
+        uint8_t                       default_search_area_height;
+        uint64_t                      searched_area_sum;
+        uint64_t                      default_search_area_sum;
+        uint64_t                      searched_sb_count;
+#endif
 
     } MeContext_t;
     typedef struct SsMeContext_s {
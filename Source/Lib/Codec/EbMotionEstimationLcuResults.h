@@ -73,6 +73,9 @@ extern "C" {
         DistDir_t    distortionDirection[3];
 
         uint8_t        totalMeCandidateIndex;
+#if ME_REFERENCE_PRUNING
+        uint8_t        prunedListMask;         // bit n set: list n dropped by the ME reference pruning, MVs not searched
+#endif
     } MeCuResults_t;
 
 #ifdef __cplusplus
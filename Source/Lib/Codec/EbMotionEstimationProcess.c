@@ -134,6 +134,19 @@ void* set_me_hme_params_oq(
     
     return EB_NULL;
 };
+#if ADAPTIVE_ME_SEARCH_AREA
+/******************************************************
+* Keep the static table search area of a picture for the
+* per SB adjustment
+******************************************************/
+static void set_me_search_area_adaptive(
+    MeContext_t                     *me_context_ptr)
+{
+    me_context_ptr->adaptive_search_area_flag = EB_TRUE;
+    me_context_ptr->default_search_area_width = me_context_ptr->search_area_width;
+    me_context_ptr->default_search_area_height = me_context_ptr->search_area_height;
+}
+#endif
 /******************************************************
 * Derive ME Settings for OQ
   Input   : encoder mode and tune
@@ -153,11 +166,20 @@ EbErrorType signal_derivation_me_kernel_oq(
             picture_control_set_ptr,
             sequence_control_set_ptr,
             sequence_control_set_ptr->input_resolution);
+#if ADAPTIVE_ME_SEARCH_AREA
+        set_me_search_area_adaptive(
+            context_ptr->me_context_ptr);
+#endif
     }
     else {
         set_me_hme_params_from_config(
             sequence_control_set_ptr,
             context_ptr->me_context_ptr);
+#if ADAPTIVE_ME_SEARCH_AREA
+        context_ptr->me_context_ptr->adaptive_search_area_flag = EB_FALSE;
+        context_ptr->me_context_ptr->default_search_area_width = context_ptr->me_context_ptr->search_area_width;
+        context_ptr->me_context_ptr->default_search_area_height = context_ptr->me_context_ptr->search_area_height;
+#endif
     }
 
     return return_error;
@@ -1072,6 +1072,110 @@ void copy_neigh_arr_32(
     return;
 }
 
+/*************************************************
+ * Neighbor Array Stash
+ *   Saves (restore = EB_FALSE) or restores
+ *   (restore = EB_TRUE) the top, left and top-left
+ *   spans covered by a block to/from a compact
+ *   SB-local buffer. Returns the number of bytes
+ *   used so that several arrays can be packed back
+ *   to back in the same buffer.
+ *************************************************/
+static uint32_t neigh_arr_stash_span(
+    uint8_t   *array_ptr,
+    uint8_t   *stash_ptr,
+    uint32_t   size,
+    EbBool     restore)
+{
+    if (restore)
+        EB_MEMCPY(array_ptr, stash_ptr, size);
+    else
+        EB_MEMCPY(stash_ptr, array_ptr, size);
+
+    return size;
+}
+
+uint32_t neigh_arr_stash(
+    NeighborArrayUnit_t   *na_unit_ptr,
+    uint8_t               *stash_ptr,
+    uint32_t               origin_x,
+    uint32_t               origin_y,
+    uint32_t               bw,
+    uint32_t               bh,
+    uint32_t               neighbor_array_type_mask,
+    EbBool                 restore)
+{
+    uint32_t naUnitSize = na_unit_ptr->unit_size;
+    uint32_t used = 0;
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
+        used += neigh_arr_stash_span(
+            na_unit_ptr->topArray + get_neighbor_array_unit_top_index(na_unit_ptr, origin_x) * naUnitSize,
+            stash_ptr + used,
+            naUnitSize * (bw >> na_unit_ptr->granularityNormalLog2),
+            restore);
+    }
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) {
+        used += neigh_arr_stash_span(
+            na_unit_ptr->leftArray + get_neighbor_array_unit_left_index(na_unit_ptr, origin_y) * naUnitSize,
+            stash_ptr + used,
+            naUnitSize * (bh >> na_unit_ptr->granularityNormalLog2),
+            restore);
+    }
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) {
+        // Bottom-row + right-column, starting from the bottom-left corner
+        used += neigh_arr_stash_span(
+            na_unit_ptr->topLeftArray + get_neighbor_array_unit_top_left_index(na_unit_ptr, origin_x, origin_y + (bh - 1)) * naUnitSize,
+            stash_ptr + used,
+            naUnitSize * (((bw + bh) >> na_unit_ptr->granularityTopLeftLog2) - 1),
+            restore);
+    }
+
+    return used;
+}
+
+uint32_t neigh_arr_stash_32(
+    NeighborArrayUnit32_t *na_unit_ptr,
+    uint8_t               *stash_ptr,
+    uint32_t               origin_x,
+    uint32_t               origin_y,
+    uint32_t               bw,
+    uint32_t               bh,
+    uint32_t               neighbor_array_type_mask,
+    EbBool                 restore)
+{
+    uint32_t naUnitSize = na_unit_ptr->unit_size;
+    uint32_t used = 0;
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
+        used += neigh_arr_stash_span(
+            (uint8_t*)(na_unit_ptr->topArray + get_neighbor_array_unit_top_index32(na_unit_ptr, origin_x)),
+            stash_ptr + used,
+            naUnitSize * (bw >> na_unit_ptr->granularityNormalLog2),
+            restore);
+    }
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) {
+        used += neigh_arr_stash_span(
+            (uint8_t*)(na_unit_ptr->leftArray + get_neighbor_array_unit_left_index32(na_unit_ptr, origin_y)),
+            stash_ptr + used,
+            naUnitSize * (bh >> na_unit_ptr->granularityNormalLog2),
+            restore);
+    }
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) {
+        used += neigh_arr_stash_span(
+            (uint8_t*)(na_unit_ptr->topLeftArray + GetNeighborArrayUnitTopLeftIndex32(na_unit_ptr, origin_x, origin_y + (bh - 1))),
+            stash_ptr + used,
+            naUnitSize * (((bw + bh) >> na_unit_ptr->granularityTopLeftLog2) - 1),
+            restore);
+    }
+
+    return used;
+}
+
 /*************************************************
  * Neighbor Array Unit Mode Write
  *************************************************/
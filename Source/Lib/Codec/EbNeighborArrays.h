@@ -150,6 +150,26 @@ extern "C" {
         uint32_t               bh,
         uint32_t               neighbor_array_type_mask);
 
+    uint32_t neigh_arr_stash(
+        NeighborArrayUnit_t   *na_unit_ptr,
+        uint8_t               *stash_ptr,
+        uint32_t               origin_x,
+        uint32_t               origin_y,
+        uint32_t               bw,
+        uint32_t               bh,
+        uint32_t               neighbor_array_type_mask,
+        EbBool                 restore);
+
+    uint32_t neigh_arr_stash_32(
+        NeighborArrayUnit32_t *na_unit_ptr,
+        uint8_t               *stash_ptr,
+        uint32_t               origin_x,
+        uint32_t               origin_y,
+        uint32_t               bw,
+        uint32_t               bh,
+        uint32_t               neighbor_array_type_mask,
+        EbBool                 restore);
+
     extern void neighbor_array_unit16bit_sample_write(
         NeighborArrayUnit_t *na_unit_ptr,
         uint16_t            *src_ptr,
@@ -14,6 +14,7 @@
 #include "EbEntropyCoding.h"
 #include "EbRateControlTasks.h"
 #include "EbSvtAv1Time.h"
+#include "RateControlTwoPass.h"
 
 static EbBool IsPassthroughData(EbLinkedListNode* dataNode)
 {
@@ -213,6 +214,8 @@ void* PacketizationKernel(void *input_ptr)
 
         // Send the number of bytes per frame to RC
         picture_control_set_ptr->parent_pcs_ptr->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        if (sequence_control_set_ptr->static_config.pass == 1)
+            two_pass_record_frame_stats(encode_context_ptr, picture_control_set_ptr);
         queueEntryPtr->av1FrameType = picture_control_set_ptr->parent_pcs_ptr->av1FrameType;
         queueEntryPtr->poc = picture_control_set_ptr->picture_number;
         memcpy(&queueEntryPtr->av1RefSignal, &picture_control_set_ptr->parent_pcs_ptr->av1RefSignal, sizeof(Av1RpsNode_t));
@@ -419,8 +422,14 @@ void* PacketizationKernel(void *input_ptr)
                 &latency);
 
             output_stream_ptr->n_tick_count = (uint32_t)latency;
+            encode_context_ptr->latency_frame_count++;
+            encode_context_ptr->total_latency_ms += output_stream_ptr->n_tick_count;
+            encode_context_ptr->max_latency_ms = MAX(encode_context_ptr->max_latency_ms, output_stream_ptr->n_tick_count);
+            if (sequence_control_set_ptr->static_config.pred_structure == EB_PRED_LOW_DELAY_P && sequence_control_set_ptr->static_config.stat_report)
+                SVT_LOG("SVT [latency]: frame %llu sent to packet in %u ms\n", (unsigned long long)queueEntryPtr->poc, output_stream_ptr->n_tick_count);
             output_stream_ptr->p_app_private = queueEntryPtr->outMetaData;
             eb_post_full_object(output_stream_wrapper_ptr);
+            encode_context_notify_output(encode_context_ptr, EB_OUTPUT_PACKET);
             queueEntryPtr->outMetaData = (EbLinkedListNode *)EB_NULL;
 
             // Reset the Reorder Queue Entry
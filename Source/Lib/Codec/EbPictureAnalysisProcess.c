@@ -16,6 +16,7 @@
 #include "EbPictureAnalysisProcess.h"
 #include "EbPictureAnalysisResults.h"
 #include "EbMcp.h"
+#include "EbPictureOperators.h"
 #include "EbMotionEstimation.h"
 #include "EbReferenceObject.h"
 
@@ -124,6 +125,42 @@ void Decimation2D(
     return;
 }
 
+/********************************************
+ * decimation_2d_fused
+ *      1/4 and 1/16 decimation of the input in one read of the input
+ *      rows, a NULL output is skipped
+ ********************************************/
+void decimation_2d_fused(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride)
+{
+    uint32_t horizontal_index;
+    uint32_t vertical_index;
+
+    for (vertical_index = 0; vertical_index < input_area_height; vertical_index += 2) {
+        // Every 4th row also feeds the 1/16 picture
+        uint8_t *sixteenth_row = (sixteenth_samples && !(vertical_index & 3)) ? sixteenth_samples + (vertical_index >> 2) * sixteenth_stride : NULL;
+
+        for (horizontal_index = 0; horizontal_index < input_area_width; horizontal_index += 2) {
+            if (quarter_samples)
+                quarter_samples[horizontal_index >> 1] = input_samples[horizontal_index];
+            if (sixteenth_row && !(horizontal_index & 3))
+                sixteenth_row[horizontal_index >> 2] = input_samples[horizontal_index];
+        }
+        input_samples += input_stride << 1;
+        if (quarter_samples)
+            quarter_samples += quarter_stride;
+    }
+
+    return;
+}
+
 /********************************************
 * CalculateHistogram
 *      creates n-bins histogram for the input
@@ -154,6 +191,25 @@ void CalculateHistogram(
     return;
 }
 
+/********************************************
+* compute_histogram_abs_diff
+*      sum of the absolute differences between
+*      the bins of two histograms
+********************************************/
+uint32_t compute_histogram_abs_diff(
+    uint32_t  *histogram_a,
+    uint32_t  *histogram_b,
+    uint32_t   bin_count)
+{
+    uint32_t bin;
+    uint32_t abs_diff = 0;
+
+    for (bin = 0; bin < bin_count; ++bin)
+        abs_diff += ABS((int32_t)histogram_a[bin] - (int32_t)histogram_b[bin]);
+
+    return abs_diff;
+}
+
 
 uint64_t ComputeVariance32x32(
     EbPictureBufferDesc_t       *inputPaddedPicturePtr,         // input parameter, Input Padded Picture
@@ -4099,7 +4155,7 @@ void SubSampleLumaGeneratePixelIntensityHistogramBins(
                 0;
 
             // Y Histogram
-            CalculateHistogram(
+            calculate_histogram_func_ptr_array[asm_type](
                 &input_picture_ptr->buffer_y[(input_picture_ptr->origin_x + regionInPictureWidthIndex * regionWidth) + ((input_picture_ptr->origin_y + regionInPictureHeightIndex * regionHeight) * input_picture_ptr->stride_y)],
                 regionWidth + regionWidthOffset,
                 regionHeight + regionHeightOffset,
@@ -4161,7 +4217,7 @@ void SubSampleChromaGeneratePixelIntensityHistogramBins(
 
 
             // U Histogram
-            CalculateHistogram(
+            calculate_histogram_func_ptr_array[asm_type](
                 &input_picture_ptr->bufferCb[((input_picture_ptr->origin_x + regionInPictureWidthIndex * regionWidth) >> 1) + (((input_picture_ptr->origin_y + regionInPictureHeightIndex * regionHeight) >> 1) * input_picture_ptr->strideCb)],
                 (regionWidth + regionWidthOffset) >> 1,
                 (regionHeight + regionHeightOffset) >> 1,
@@ -4180,7 +4236,7 @@ void SubSampleChromaGeneratePixelIntensityHistogramBins(
             }
 
             // V Histogram
-            CalculateHistogram(
+            calculate_histogram_func_ptr_array[asm_type](
                 &input_picture_ptr->bufferCr[((input_picture_ptr->origin_x + regionInPictureWidthIndex * regionWidth) >> 1) + (((input_picture_ptr->origin_y + regionInPictureHeightIndex * regionHeight) >> 1) * input_picture_ptr->strideCr)],
                 (regionWidth + regionWidthOffset) >> 1,
                 (regionHeight + regionHeightOffset) >> 1,
@@ -4543,68 +4599,70 @@ void DetermineHomogeneousRegionInPicture(
     return;
 }
 /************************************************
- * ComputePictureSpatialStatistics
- ** Compute Block Variance
- ** Compute Picture Variance
- ** Compute Block Mean for all blocks in the picture
+ * Spatial statistics of one SB: block means and
+ * variances, chroma block means
  ************************************************/
-void ComputePictureSpatialStatistics(
+static void ComputeSbSpatialStatistics(
     SequenceControlSet_t            *sequence_control_set_ptr,
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *input_picture_ptr,
     EbPictureBufferDesc_t           *inputPaddedPicturePtr,
-    uint32_t                           sb_total_count,
-    EbAsm                           asm_type)
+    uint32_t                         sb_index,
+    EbAsm                            asm_type)
 {
-    uint32_t sb_index;
-    uint32_t sb_origin_x;        // to avoid using child PCS
-    uint32_t sb_origin_y;
-    uint32_t inputLumaOriginIndex;
-    uint32_t inputCbOriginIndex;
-    uint32_t inputCrOriginIndex;
-    uint64_t picTotVariance;
-
-    // Variance
-    picTotVariance = 0;
-
-    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
-        SbParams_t   *sb_params = &sequence_control_set_ptr->sb_params_array[sb_index];
-
-        sb_origin_x = sb_params->origin_x;
-        sb_origin_y = sb_params->origin_y;
-        inputLumaOriginIndex = (inputPaddedPicturePtr->origin_y + sb_origin_y) * inputPaddedPicturePtr->stride_y +
-            inputPaddedPicturePtr->origin_x + sb_origin_x;
+    SbParams_t   *sb_params = &sequence_control_set_ptr->sb_params_array[sb_index];
+    uint32_t sb_origin_x = sb_params->origin_x;        // to avoid using child PCS
+    uint32_t sb_origin_y = sb_params->origin_y;
+    uint32_t inputLumaOriginIndex = (inputPaddedPicturePtr->origin_y + sb_origin_y) * inputPaddedPicturePtr->stride_y +
+        inputPaddedPicturePtr->origin_x + sb_origin_x;
+    uint32_t inputCbOriginIndex = ((input_picture_ptr->origin_y + sb_origin_y) >> 1) * input_picture_ptr->strideCb + ((input_picture_ptr->origin_x + sb_origin_x) >> 1);
+    uint32_t inputCrOriginIndex = ((input_picture_ptr->origin_y + sb_origin_y) >> 1) * input_picture_ptr->strideCr + ((input_picture_ptr->origin_x + sb_origin_x) >> 1);
+
+    ComputeBlockMeanComputeVariance(
+        sequence_control_set_ptr,
+        picture_control_set_ptr,
+        inputPaddedPicturePtr,
+        sb_index,
+        inputLumaOriginIndex,
+        asm_type);
 
-        inputCbOriginIndex = ((input_picture_ptr->origin_y + sb_origin_y) >> 1) * input_picture_ptr->strideCb + ((input_picture_ptr->origin_x + sb_origin_x) >> 1);
-        inputCrOriginIndex = ((input_picture_ptr->origin_y + sb_origin_y) >> 1) * input_picture_ptr->strideCr + ((input_picture_ptr->origin_x + sb_origin_x) >> 1);
+    if (sb_params->is_complete_sb) {
 
-        ComputeBlockMeanComputeVariance(
+        ComputeChromaBlockMean(
             sequence_control_set_ptr,
             picture_control_set_ptr,
-            inputPaddedPicturePtr,
+            input_picture_ptr,
             sb_index,
-            inputLumaOriginIndex,
+            inputCbOriginIndex,
+            inputCrOriginIndex,
             asm_type);
+    }
+    else {
+        ZeroOutChromaBlockMean(
+            picture_control_set_ptr,
+            sb_index);
+    }
 
-        if (sb_params->is_complete_sb) {
+    return;
+}
 
-            ComputeChromaBlockMean(
-                sequence_control_set_ptr,
-                picture_control_set_ptr,
-                input_picture_ptr,
-                sb_index,
-                inputCbOriginIndex,
-                inputCrOriginIndex,
-                asm_type);
-        }
-        else {
-            ZeroOutChromaBlockMean(
-                picture_control_set_ptr,
-                sb_index);
-        }
+/************************************************
+ * Picture level spatial statistics, from the SB
+ * statistics of the analysis sweep
+ ************************************************/
+void ComputePictureSpatialStatistics(
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    uint32_t                           sb_total_count)
+{
+    uint32_t sb_index;
+    uint64_t picTotVariance;
 
+    // Variance
+    picTotVariance = 0;
+
+    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index)
         picTotVariance += (picture_control_set_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
-    }
 
     picture_control_set_ptr->pic_avg_variance = (uint16_t)(picTotVariance / sb_total_count);
     // Calculate the variance of variance to determine Homogeneous regions. Note: Variance calculation should be on.
@@ -4674,13 +4732,12 @@ void CalculateInputAverageIntensity(
 /************************************************
  * Gathering statistics per picture
  ** Calculating the pixel intensity histogram bins per picture needed for SCD
- ** Computing Picture Variance
+ ** Computing Picture Variance from the SB variances of the analysis sweep
  ************************************************/
 void GatheringPictureStatistics(
     SequenceControlSet_t            *sequence_control_set_ptr,
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *input_picture_ptr,
-    EbPictureBufferDesc_t           *inputPaddedPicturePtr,
     EbPictureBufferDesc_t            *sixteenthDecimatedPicturePtr,
     uint32_t                           sb_total_count,
     EbAsm                           asm_type)
@@ -4724,10 +4781,7 @@ void GatheringPictureStatistics(
     ComputePictureSpatialStatistics(
         sequence_control_set_ptr,
         picture_control_set_ptr,
-        input_picture_ptr,
-        inputPaddedPicturePtr,
-        sb_total_count,
-        asm_type);
+        sb_total_count);
 
     return;
 }
@@ -4740,6 +4794,67 @@ void PadPictureToMultipleOfMinCuSizeDimensions(
     EbPictureBufferDesc_t           *input_picture_ptr)
 {
     EbBool                          is16BitInput = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    if (input_picture_ptr->buffer_16bit_y) {
+        uint32_t lumaOffset = input_picture_ptr->origin_x + (input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+        uint32_t cbOffset = (input_picture_ptr->origin_x >> 1) + ((input_picture_ptr->origin_y >> 1) * input_picture_ptr->strideCb);
+        uint32_t crOffset = (input_picture_ptr->origin_x >> 1) + ((input_picture_ptr->origin_y >> 1) * input_picture_ptr->strideCr);
+
+        // Native 16bit input: pad the 16bit planes, then derive the 8bit planes (padding included) from them
+        pad_input_picture_16bit(
+            &input_picture_ptr->buffer_16bit_y[lumaOffset],
+            input_picture_ptr->stride_y,
+            (input_picture_ptr->width - sequence_control_set_ptr->pad_right),
+            (input_picture_ptr->height - sequence_control_set_ptr->pad_bottom),
+            sequence_control_set_ptr->pad_right,
+            sequence_control_set_ptr->pad_bottom);
+
+        pad_input_picture_16bit(
+            &input_picture_ptr->buffer_16bit_cb[cbOffset],
+            input_picture_ptr->strideCb,
+            (input_picture_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
+            (input_picture_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+            sequence_control_set_ptr->pad_right >> 1,
+            sequence_control_set_ptr->pad_bottom >> 1);
+
+        pad_input_picture_16bit(
+            &input_picture_ptr->buffer_16bit_cr[crOffset],
+            input_picture_ptr->strideCr,
+            (input_picture_ptr->width - sequence_control_set_ptr->pad_right) >> 1,
+            (input_picture_ptr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+            sequence_control_set_ptr->pad_right >> 1,
+            sequence_control_set_ptr->pad_bottom >> 1);
+
+        extract_8bit_data(
+            &input_picture_ptr->buffer_16bit_y[lumaOffset],
+            input_picture_ptr->stride_y,
+            &input_picture_ptr->buffer_y[lumaOffset],
+            input_picture_ptr->stride_y,
+            input_picture_ptr->width,
+            input_picture_ptr->height,
+            sequence_control_set_ptr->encode_context_ptr->asm_type);
+
+        extract_8bit_data(
+            &input_picture_ptr->buffer_16bit_cb[cbOffset],
+            input_picture_ptr->strideCb,
+            &input_picture_ptr->bufferCb[cbOffset],
+            input_picture_ptr->strideCb,
+            input_picture_ptr->width >> 1,
+            input_picture_ptr->height >> 1,
+            sequence_control_set_ptr->encode_context_ptr->asm_type);
+
+        extract_8bit_data(
+            &input_picture_ptr->buffer_16bit_cr[crOffset],
+            input_picture_ptr->strideCr,
+            &input_picture_ptr->bufferCr[crOffset],
+            input_picture_ptr->strideCr,
+            input_picture_ptr->width >> 1,
+            input_picture_ptr->height >> 1,
+            sequence_control_set_ptr->encode_context_ptr->asm_type);
+
+        return;
+    }
+
     // Input Picture Padding
     pad_input_picture(
         &input_picture_ptr->buffer_y[input_picture_ptr->origin_x + (input_picture_ptr->origin_y * input_picture_ptr->stride_y)],
@@ -4818,27 +4933,48 @@ void PadPictureToMultipleOfLcuDimensions(
 }
 
 /************************************************
-* 1/4 & 1/16 input picture decimation
+* 1/4 & 1/16 input picture decimation of the rows
+* [row_start, row_start + row_count), row_start multiple of 4
 ************************************************/
-void DecimateInputPicture(
+void DecimateInputPictureRows(
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *inputPaddedPicturePtr,
     EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
-    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr) {
-
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr,
+    uint32_t                         row_start,
+    uint32_t                         row_count,
+    EbAsm                            asm_type) {
 
     // Decimate input picture for HME L0 and L1
+    if (picture_control_set_ptr->enable_hme_flag && (picture_control_set_ptr->enable_hme_level1_flag || picture_control_set_ptr->enable_hme_level0_flag)) {
+
+        decimation_2d_fused_func_ptr_array[asm_type](
+            &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + (inputPaddedPicturePtr->origin_y + row_start) * inputPaddedPicturePtr->stride_y],
+            inputPaddedPicturePtr->stride_y,
+            inputPaddedPicturePtr->width,
+            row_count,
+            picture_control_set_ptr->enable_hme_level1_flag ?
+                &quarterDecimatedPicturePtr->buffer_y[quarterDecimatedPicturePtr->origin_x + (quarterDecimatedPicturePtr->origin_x + (row_start >> 1))*quarterDecimatedPicturePtr->stride_y] :
+                NULL,
+            quarterDecimatedPicturePtr->stride_y,
+            picture_control_set_ptr->enable_hme_level0_flag ?
+                &sixteenthDecimatedPicturePtr->buffer_y[sixteenthDecimatedPicturePtr->origin_x + (sixteenthDecimatedPicturePtr->origin_x + (row_start >> 2))*sixteenthDecimatedPicturePtr->stride_y] :
+                NULL,
+            sixteenthDecimatedPicturePtr->stride_y);
+    }
+}
+
+/************************************************
+* 1/4 & 1/16 decimated pictures padding
+************************************************/
+void PadDecimatedInputPicture(
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr) {
+
     if (picture_control_set_ptr->enable_hme_flag) {
 
         if (picture_control_set_ptr->enable_hme_level1_flag) {
-            Decimation2D(
-                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + inputPaddedPicturePtr->origin_y * inputPaddedPicturePtr->stride_y],
-                inputPaddedPicturePtr->stride_y,
-                inputPaddedPicturePtr->width,
-                inputPaddedPicturePtr->height,
-                &quarterDecimatedPicturePtr->buffer_y[quarterDecimatedPicturePtr->origin_x + quarterDecimatedPicturePtr->origin_x*quarterDecimatedPicturePtr->stride_y],
-                quarterDecimatedPicturePtr->stride_y,
-                2);
             generate_padding(
                 &quarterDecimatedPicturePtr->buffer_y[0],
                 quarterDecimatedPicturePtr->stride_y,
@@ -4846,21 +4982,9 @@ void DecimateInputPicture(
                 quarterDecimatedPicturePtr->height,
                 quarterDecimatedPicturePtr->origin_x,
                 quarterDecimatedPicturePtr->origin_y);
-
         }
 
         if (picture_control_set_ptr->enable_hme_level0_flag) {
-
-            // Sixteenth Input Picture Decimation
-            Decimation2D(
-                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + inputPaddedPicturePtr->origin_y * inputPaddedPicturePtr->stride_y],
-                inputPaddedPicturePtr->stride_y,
-                inputPaddedPicturePtr->width,
-                inputPaddedPicturePtr->height,
-                &sixteenthDecimatedPicturePtr->buffer_y[sixteenthDecimatedPicturePtr->origin_x + sixteenthDecimatedPicturePtr->origin_x*sixteenthDecimatedPicturePtr->stride_y],
-                sixteenthDecimatedPicturePtr->stride_y,
-                4);
-
             generate_padding(
                 &sixteenthDecimatedPicturePtr->buffer_y[0],
                 sixteenthDecimatedPicturePtr->stride_y,
@@ -4868,7 +4992,53 @@ void DecimateInputPicture(
                 sixteenthDecimatedPicturePtr->height,
                 sixteenthDecimatedPicturePtr->origin_x,
                 sixteenthDecimatedPicturePtr->origin_y);
+        }
+    }
+}
+
+/************************************************
+ * Analysis sweep
+ ** One pass over the SB rows [sb_row_start, sb_row_end) of the input
+ ** picture: the rows of an SB row are decimated, then the statistics of
+ ** its SBs are gathered while the rows are still in cache
+ ************************************************/
+void AnalyzeInputPictureSbRows(
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    EbPictureBufferDesc_t           *input_picture_ptr,
+    EbPictureBufferDesc_t           *inputPaddedPicturePtr,
+    EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr,
+    uint32_t                         picture_width_in_sb,
+    uint32_t                         sb_row_start,
+    uint32_t                         sb_row_end,
+    EbAsm                            asm_type) {
 
+    uint32_t sb_row_index;
+    uint32_t sb_index;
+
+    for (sb_row_index = sb_row_start; sb_row_index < sb_row_end; ++sb_row_index) {
+        uint32_t row_start = sb_row_index * sequence_control_set_ptr->sb_sz;
+
+        if (row_start < inputPaddedPicturePtr->height) {
+            DecimateInputPictureRows(
+                picture_control_set_ptr,
+                inputPaddedPicturePtr,
+                quarterDecimatedPicturePtr,
+                sixteenthDecimatedPicturePtr,
+                row_start,
+                MIN(sequence_control_set_ptr->sb_sz, inputPaddedPicturePtr->height - row_start),
+                asm_type);
+        }
+
+        for (sb_index = sb_row_index * picture_width_in_sb; sb_index < (sb_row_index + 1) * picture_width_in_sb && sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
+            ComputeSbSpatialStatistics(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                input_picture_ptr,
+                inputPaddedPicturePtr,
+                sb_index,
+                asm_type);
         }
     }
 }
@@ -4879,6 +5049,10 @@ void DecimateInputPicture(
  * The Picture Analysis also includes creating an n-bin Histogram,
  * gathering picture 1st and 2nd moment statistics for each 8x8 block,
  * which are used to compute variance.
+ * A picture is split in SB row segments, processed by several
+ * Picture Analysis processes: the first segment runs the picture
+ * level pre processing, the last one to finish merges the picture
+ * level statistics.
  * The Picture Analysis process is multithreaded, so pictures can be
  * processed out of order as long as all inputs are available.
  ************************************************/
@@ -4905,6 +5079,11 @@ void* picture_analysis_kernel(void *input_ptr)
     uint32_t                          sb_total_count;
     EbAsm                          asm_type;
 
+    // Segments
+    uint32_t                          segment_index;
+    uint32_t                          segments_total_count;
+    EbBool                            last_segment_flag;
+
     for (;;) {
 
         // Get Input Full Object
@@ -4929,35 +5108,73 @@ void* picture_analysis_kernel(void *input_ptr)
 
         asm_type = sequence_control_set_ptr->encode_context_ptr->asm_type;
 
-        // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
-        SetPictureParametersForStatisticsGathering(
-            sequence_control_set_ptr);
+        segment_index = inputResultsPtr->segment_index;
+        segments_total_count = picture_control_set_ptr->pa_segments_total_count;
 
-        // Pad pictures to multiple min cu size
-        PadPictureToMultipleOfMinCuSizeDimensions(
-            sequence_control_set_ptr,
-            input_picture_ptr);
+        if (segment_index == 0) {
+
+            // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
+            SetPictureParametersForStatisticsGathering(
+                sequence_control_set_ptr);
+
+            // Pad pictures to multiple min cu size
+            PadPictureToMultipleOfMinCuSizeDimensions(
+                sequence_control_set_ptr,
+                input_picture_ptr);
+
+            // Pre processing operations performed on the input picture
+            PicturePreProcessingOperations(
+                picture_control_set_ptr,
+                input_picture_ptr,
+                context_ptr,
+                sequence_control_set_ptr,
+                quarterDecimatedPicturePtr,
+                sixteenthDecimatedPicturePtr,
+                sb_total_count,
+                picture_width_in_sb,
+                asm_type);
+
+            // Pad input picture to complete border LCUs
+            PadPictureToMultipleOfLcuDimensions(
+                inputPaddedPicturePtr);
+
+            // Release the other segments of the picture
+            for (uint32_t waiting_index = 1; waiting_index < segments_total_count; ++waiting_index)
+                eb_post_semaphore(picture_control_set_ptr->pa_pre_processing_semaphore);
+        }
+        else {
+            // The segments are posted in order, so the first one is already being processed
+            EbHandle core_budget = eb_core_budget_suspend();
+            eb_block_on_semaphore(picture_control_set_ptr->pa_pre_processing_semaphore);
+            eb_core_budget_resume(core_budget);
+        }
 
-        // Pre processing operations performed on the input picture
-        PicturePreProcessingOperations(
+        // 1/4 & 1/16 input picture decimation and SB statistics, in one sweep over the SB rows of the segment
+        AnalyzeInputPictureSbRows(
+            sequence_control_set_ptr,
             picture_control_set_ptr,
             input_picture_ptr,
-            context_ptr,
-            sequence_control_set_ptr,
+            inputPaddedPicturePtr,
             quarterDecimatedPicturePtr,
             sixteenthDecimatedPicturePtr,
-            sb_total_count,
             picture_width_in_sb,
+            SEGMENT_START_IDX(segment_index, pictureHeighInLcu, segments_total_count),
+            SEGMENT_END_IDX(segment_index, pictureHeighInLcu, segments_total_count),
             asm_type);
 
-        // Pad input picture to complete border LCUs
-        PadPictureToMultipleOfLcuDimensions(
-            inputPaddedPicturePtr);
+        eb_block_on_mutex(picture_control_set_ptr->pa_segment_mutex);
+        last_segment_flag = (++picture_control_set_ptr->pa_segments_completed_count == segments_total_count) ? EB_TRUE : EB_FALSE;
+        eb_release_mutex(picture_control_set_ptr->pa_segment_mutex);
 
-        // 1/4 & 1/16 input picture decimation
-        DecimateInputPicture(
+        if (last_segment_flag == EB_FALSE) {
+            // Release the Input Results
+            eb_release_object(inputResultsWrapperPtr);
+            continue;
+        }
+
+        // Last segment: pad the decimated pictures and merge the picture level statistics
+        PadDecimatedInputPicture(
             picture_control_set_ptr,
-            inputPaddedPicturePtr,
             quarterDecimatedPicturePtr,
             sixteenthDecimatedPicturePtr);
 
@@ -4966,7 +5183,6 @@ void* picture_analysis_kernel(void *input_ptr)
             sequence_control_set_ptr,
             picture_control_set_ptr,
             input_picture_ptr,
-            inputPaddedPicturePtr,
             sixteenthDecimatedPicturePtr,
             sb_total_count,
             asm_type);
@@ -9,6 +9,7 @@
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
 #include "EbNoiseExtractAVX2.h"
+#include "EbPictureAnalysis_AVX2.h"
 
 /**************************************
  * Context
@@ -137,5 +138,77 @@ static EB_WEAKCHROMAFILTER_TYPE FUNC_TABLE weak_chroma_filter_func_ptr_array[ASM
 
 };
 
+void decimation_2d_fused(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride);
+
+typedef void(*EB_DECIMATION_2D_FUSED_TYPE)(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride);
+
+static EB_DECIMATION_2D_FUSED_TYPE FUNC_TABLE decimation_2d_fused_func_ptr_array[ASM_TYPE_TOTAL] =
+{
+    // NON_AVX2
+    decimation_2d_fused,
+    // AVX2
+    decimation_2d_fused_avx2_intrin,
+};
+
+void CalculateHistogram(
+    uint8_t  *input_samples,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint32_t  stride,
+    uint8_t   decimStep,
+    uint32_t *histogram,
+    uint64_t *sum);
+
+typedef void(*EB_CALCULATE_HISTOGRAM_TYPE)(
+    uint8_t  *input_samples,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint32_t  stride,
+    uint8_t   decimStep,
+    uint32_t *histogram,
+    uint64_t *sum);
+
+static EB_CALCULATE_HISTOGRAM_TYPE FUNC_TABLE calculate_histogram_func_ptr_array[ASM_TYPE_TOTAL] =
+{
+    // NON_AVX2
+    CalculateHistogram,
+    // AVX2
+    calculate_histogram_avx2_intrin,
+};
+
+uint32_t compute_histogram_abs_diff(
+    uint32_t *histogram_a,
+    uint32_t *histogram_b,
+    uint32_t  bin_count);
+
+typedef uint32_t(*EB_COMPUTE_HISTOGRAM_ABS_DIFF_TYPE)(
+    uint32_t *histogram_a,
+    uint32_t *histogram_b,
+    uint32_t  bin_count);
+
+static EB_COMPUTE_HISTOGRAM_ABS_DIFF_TYPE FUNC_TABLE compute_histogram_abs_diff_func_ptr_array[ASM_TYPE_TOTAL] =
+{
+    // NON_AVX2
+    compute_histogram_abs_diff,
+    // AVX2
+    compute_histogram_abs_diff_avx2_intrin,
+};
+
 
 #endif // EbPictureAnalysis_h
\ No newline at end of file
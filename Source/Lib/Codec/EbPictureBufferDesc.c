@@ -68,6 +68,9 @@ EbErrorType eb_picture_buffer_desc_ctor(
         pictureBufferDescPtr->strideBitIncCb = 0;
         pictureBufferDescPtr->strideBitIncCr = 0;
     }
+    pictureBufferDescPtr->buffer_16bit_y = 0;
+    pictureBufferDescPtr->buffer_16bit_cb = 0;
+    pictureBufferDescPtr->buffer_16bit_cr = 0;
 
     // Allocate the Picture Buffers (luma & chroma)
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Y_FLAG) {
@@ -164,6 +167,9 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(
     pictureBufferDescPtr->strideBitIncY = 0;
     pictureBufferDescPtr->strideBitIncCb = 0;
     pictureBufferDescPtr->strideBitIncCr = 0;
+    pictureBufferDescPtr->buffer_16bit_y = 0;
+    pictureBufferDescPtr->buffer_16bit_cb = 0;
+    pictureBufferDescPtr->buffer_16bit_cr = 0;
 
     // Allocate the Picture Buffers (luma & chroma)
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Y_FLAG) {
@@ -36,6 +36,10 @@ extern "C" {
         EbByte         bufferBitIncY;       // pointer to the Y luma buffer Bit increment
         EbByte         bufferBitIncCb;      // pointer to the U chroma buffer Bit increment
         EbByte         bufferBitIncCr;      // pointer to the V chroma buffer Bit increment
+        // Native 16bit samples (uncompressed 10bit input), same strides as the 8bit buffers
+        uint16_t      *buffer_16bit_y;      // pointer to the Y luma 16bit buffer
+        uint16_t      *buffer_16bit_cb;     // pointer to the U chroma 16bit buffer
+        uint16_t      *buffer_16bit_cr;     // pointer to the V chroma 16bit buffer
 
         uint16_t          stride_y;          // pointer to the Y luma buffer
         uint16_t          strideCb;         // pointer to the U chroma buffer
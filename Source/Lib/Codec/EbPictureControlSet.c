@@ -1065,6 +1065,10 @@ EbErrorType picture_parent_control_set_ctor(
 
     EB_CREATEMUTEX(EbHandle, object_ptr->rc_distortion_histogram_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    // Picture analysis segments
+    EB_CREATESEMAPHORE(EbHandle, object_ptr->pa_pre_processing_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, SEGMENT_MAX_COUNT);
+    EB_CREATEMUTEX(EbHandle, object_ptr->pa_segment_mutex, sizeof(EbHandle), EB_MUTEX);
+
 #if ADAPTIVE_DEPTH_PARTITIONING
     EB_MALLOC(EB_SB_DEPTH_MODE*, object_ptr->sb_depth_mode_array, sizeof(EB_SB_DEPTH_MODE) * object_ptr->sb_total_count, EB_N_PTR);
 #else
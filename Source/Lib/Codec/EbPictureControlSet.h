@@ -54,7 +54,7 @@ extern "C" {
 
 // BDP OFF
 #define MD_NEIGHBOR_ARRAY_INDEX                0
-#define NEIGHBOR_ARRAY_TOTAL_COUNT             4
+#define NEIGHBOR_ARRAY_TOTAL_COUNT             1
 #define AOM_QM_BITS                            5
 #define QM_TOTAL_SIZE                          3344
 
@@ -14069,6 +14069,10 @@ extern "C" {
         uint8_t                               me_segments_column_count;
         uint8_t                               me_segments_row_count;
         uint64_t                              me_segments_completion_mask;
+        uint16_t                              pa_segments_total_count;
+        uint16_t                              pa_segments_completed_count;
+        EbHandle                              pa_pre_processing_semaphore;
+        EbHandle                              pa_segment_mutex;
 
         // Motion Estimation Results
         uint8_t                               max_number_of_pus_per_sb;
@@ -14120,6 +14124,12 @@ extern "C" {
         EbPictureDepthMode                    pic_depth_mode;
         uint8_t                               loop_filter_mode;
         uint8_t                               intra_pred_mode;
+#if OIS_MD_INTRA_PRUNING
+        uint8_t                               ois_intra_pruning_level;
+#endif
+#if ME_REFERENCE_PRUNING
+        uint8_t                               me_reference_pruning_level;
+#endif
 #if TWO_FAST_LOOP
         uint8_t                               enable_two_fast_loops;
 #endif
@@ -14280,7 +14290,9 @@ extern "C" {
         uint8_t                               tx_search_level;
         uint64_t                              tx_weight;
         uint8_t                               tx_search_reduced_set;
+        uint8_t                               tx_search_prune_level;
         uint8_t                               interpolation_search_level;
+        uint8_t                               interpolation_filter_prune_th;
         uint8_t                               nsq_search_level;
 
     } PictureParentControlSet_t;
@@ -12,6 +12,7 @@
 #include "EbSequenceControlSet.h"
 #include "EbPictureAnalysisResults.h"
 #include "EbPictureDecisionProcess.h"
+#include "EbPictureAnalysisProcess.h"
 #include "EbPictureDecisionResults.h"
 #include "EbReferenceObject.h"
 #include "EbSvtAv1ErrorCodes.h"
@@ -89,6 +90,12 @@ EbErrorType picture_decision_context_ctor(
     return EB_ErrorNone;
 }
 
+/***************************************************************************************************
+* SceneTransitionDetector
+*   ParentPcsWindow holds the previous, current and windowWidthFuture future pictures.
+*   With no future picture (low delay), flashes cannot be told from scene changes: an abrupt
+*   change is a scene change unless the average intensity barely moved (fade).
+***************************************************************************************************/
 EbBool SceneTransitionDetector(
     PictureDecisionContext_t *context_ptr,
     SequenceControlSet_t                 *sequence_control_set_ptr,
@@ -97,7 +104,8 @@ EbBool SceneTransitionDetector(
 {
     PictureParentControlSet_t       *previousPictureControlSetPtr = ParentPcsWindow[0];
     PictureParentControlSet_t       *currentPictureControlSetPtr = ParentPcsWindow[1];
-    PictureParentControlSet_t       *futurePictureControlSetPtr = ParentPcsWindow[2];
+    PictureParentControlSet_t       *futurePictureControlSetPtr = windowWidthFuture ? ParentPcsWindow[2] : (PictureParentControlSet_t*)EB_NULL;
+    EbAsm                            asm_type = sequence_control_set_ptr->encode_context_ptr->asm_type;
 
     // calculating the frame threshold based on the number of 64x64 blocks in the frame
     uint32_t  regionThreshHold;
@@ -129,8 +137,6 @@ EbBool SceneTransitionDetector(
     uint8_t   aidFuturePresent = 0;
     uint8_t   aidPresentPast = 0;
 
-    uint32_t  bin = 0; // variable used to iterate through the bins of the histograms
-
     uint32_t  regionInPictureWidthIndex;
     uint32_t  regionInPictureHeightIndex;
 
@@ -183,12 +189,18 @@ EbBool SceneTransitionDetector(
 
             regionThreshHoldChroma = regionThreshHold / 4;
 
-            for (bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) {
-                ahd += ABS((int32_t)currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0][bin] - (int32_t)previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0][bin]);
-                ahdCb += ABS((int32_t)currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1][bin] - (int32_t)previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1][bin]);
-                ahdCr += ABS((int32_t)currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2][bin] - (int32_t)previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2][bin]);
-
-            }
+            ahd = compute_histogram_abs_diff_func_ptr_array[asm_type](
+                currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0],
+                previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][0],
+                HISTOGRAM_NUMBER_OF_BINS);
+            ahdCb = compute_histogram_abs_diff_func_ptr_array[asm_type](
+                currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1],
+                previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][1],
+                HISTOGRAM_NUMBER_OF_BINS);
+            ahdCr = compute_histogram_abs_diff_func_ptr_array[asm_type](
+                currentPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2],
+                previousPictureControlSetPtr->picture_histogram[regionInPictureWidthIndex][regionInPictureHeightIndex][2],
+                HISTOGRAM_NUMBER_OF_BINS);
 
             if (context_ptr->resetRunningAvg) {
                 ahdRunningAvg[regionInPictureWidthIndex][regionInPictureHeightIndex] = ahd;
@@ -212,7 +224,15 @@ EbBool SceneTransitionDetector(
                 gradualChange = EB_TRUE;
             }
 
-            if (isAbruptChange)
+            if (isAbruptChange && futurePictureControlSetPtr == EB_NULL) {
+                aidPresentPast = (uint8_t)ABS((int16_t)currentPictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0] - (int16_t)previousPictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0]);
+
+                if (aidPresentPast < FADE_TH)
+                    isFade = EB_TRUE;
+                else
+                    isSceneChange = EB_TRUE;
+            }
+            else if (isAbruptChange)
             {
                 aidFuturePast = (uint8_t)ABS((int16_t)futurePictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0] - (int16_t)previousPictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0]);
                 aidFuturePresent = (uint8_t)ABS((int16_t)futurePictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0] - (int16_t)currentPictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0]);
@@ -232,6 +252,9 @@ EbBool SceneTransitionDetector(
                 }
 
             }
+            else if (gradualChange && futurePictureControlSetPtr == EB_NULL) {
+                ahdRunningAvg[regionInPictureWidthIndex][regionInPictureHeightIndex] = (3 * ahdRunningAvg[regionInPictureWidthIndex][regionInPictureHeightIndex] + ahd) / 4;
+            }
             else if (gradualChange) {
 
                 aidFuturePast = (uint8_t)ABS((int16_t)futurePictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0] - (int16_t)previousPictureControlSetPtr->average_intensity_per_region[regionInPictureWidthIndex][regionInPictureHeightIndex][0]);
@@ -256,7 +279,6 @@ EbBool SceneTransitionDetector(
         }
     }
 
-    (void)windowWidthFuture;
     (void)isFlash;
     (void)isFade;
 
@@ -702,6 +724,14 @@ EbErrorType signal_derivation_multi_processes_oq(
     else
         picture_control_set_ptr->interpolation_search_level = IT_SEARCH_OFF;
 
+    // Interpolation filter pruning threshold (%). The vertical filters are not searched
+    // when EIGHTTAP_REGULAR beats the other horizontal filters by this margin
+    // 0                                              OFF
+    if (MR_MODE)
+        picture_control_set_ptr->interpolation_filter_prune_th = 0;
+    else
+        picture_control_set_ptr->interpolation_filter_prune_th = 5;
+
     // Loop filter Level                            Settings
     // 0                                            OFF
     // 1                                            CU-BASED
@@ -789,6 +819,17 @@ EbErrorType signal_derivation_multi_processes_oq(
     else
         picture_control_set_ptr->tx_search_reduced_set = 1;
 
+    // Tx search pruning level                      Settings
+    // 0                                            OFF
+    // 1                                            Stop when DCT_DCT quantizes to zero
+    // 2                                            1 + residual energy based ADST / FLIPADST pruning
+    if (MR_MODE)
+        picture_control_set_ptr->tx_search_prune_level = 0;
+    else if (picture_control_set_ptr->enc_mode <= ENC_M1)
+        picture_control_set_ptr->tx_search_prune_level = 1;
+    else
+        picture_control_set_ptr->tx_search_prune_level = 2;
+
     // Intra prediction levels                      Settings
     // 0                                            OFF : disable_angle_prediction
     // 1                                            OFF per block : disable_angle_prediction for 64/32/4
@@ -816,6 +857,33 @@ EbErrorType signal_derivation_multi_processes_oq(
     if (MR_MODE)
         picture_control_set_ptr->intra_pred_mode = 4;
 
+#if OIS_MD_INTRA_PRUNING
+    // OIS based intra pruning level                Settings
+    // 0                                            OFF
+    // 1                                            Skip the directional candidates more than 45 degrees away from the OIS best direction
+    // 2                                            Skip the directional candidates more than 22 degrees away from the OIS best direction
+    // I slices search 7 OIS modes only (45 degrees apart): at most level 1
+    if (MR_MODE || picture_control_set_ptr->enc_mode <= ENC_M1)
+        picture_control_set_ptr->ois_intra_pruning_level = 0;
+    else if (picture_control_set_ptr->enc_mode <= ENC_M5 || picture_control_set_ptr->slice_type == I_SLICE)
+        picture_control_set_ptr->ois_intra_pruning_level = 1;
+    else
+        picture_control_set_ptr->ois_intra_pruning_level = 2;
+#endif
+
+#if ME_REFERENCE_PRUNING
+    // ME reference pruning level                   Settings
+    // 0                                            OFF
+    // 1                                            Drop a reference with an HME level 0 SAD 50% (100% if temporally closer) above the other reference
+    // 2                                            Drop a reference with an HME level 0 SAD 25% (50% if temporally closer) above the other reference
+    if (MR_MODE || picture_control_set_ptr->enc_mode <= ENC_M1)
+        picture_control_set_ptr->me_reference_pruning_level = 0;
+    else if (picture_control_set_ptr->enc_mode <= ENC_M5)
+        picture_control_set_ptr->me_reference_pruning_level = 1;
+    else
+        picture_control_set_ptr->me_reference_pruning_level = 2;
+#endif
+
 
 #if TWO_FAST_LOOP
 		// Intra candidates are procsssed in a first fast loop , the best is injected into the second fast loop with Inter candidates.  
@@ -1477,6 +1545,7 @@ void* picture_decision_kernel(void *input_ptr)
 
     EbBool                          windowAvail, framePasseThru;
     uint32_t                           windowIndex;
+    uint32_t                           windowWidthFuture;
     uint32_t                           entryIndex;
     PictureParentControlSet_t        *ParentPcsWindow[FUTURE_WINDOW_WIDTH + 2];
 
@@ -1554,6 +1623,14 @@ void* picture_decision_kernel(void *input_ptr)
                     }
                 }
             }
+            // Low delay does not wait for the future window: single picture scene transition detection
+            windowWidthFuture = FUTURE_WINDOW_WIDTH;
+            if (sequence_control_set_ptr->static_config.pred_structure == EB_PRED_LOW_DELAY_P) {
+                windowAvail = (encode_context_ptr->picture_decision_reorder_queue[previousEntryIndex]->parentPcsWrapperPtr != NULL &&
+                    ((PictureParentControlSet_t *)(queueEntryPtr->parentPcsWrapperPtr->object_ptr))->end_of_sequence_flag == EB_FALSE) ? EB_TRUE : EB_FALSE;
+                windowWidthFuture = 0;
+                framePasseThru = EB_TRUE;
+            }
             picture_control_set_ptr = (PictureParentControlSet_t*)queueEntryPtr->parentPcsWrapperPtr->object_ptr;
 
             picture_control_set_ptr->fade_out_from_black = 0;
@@ -1569,7 +1646,7 @@ void* picture_decision_kernel(void *input_ptr)
                         context_ptr,
                         sequence_control_set_ptr,
                         ParentPcsWindow,
-                        FUTURE_WINDOW_WIDTH);
+                        windowWidthFuture);
 
 
                 }
@@ -388,16 +388,23 @@ void mode_decision_update_neighbor_arrays(
     return;
 }
 
-void copy_neighbour_arrays(
+/*******************************************
+* Stash Neighbour Arrays
+*   Saves (restore = EB_FALSE) the MD neighbor
+*   spans covered by a square block into the
+*   SB-local stash of the MD context, or restores
+*   them (restore = EB_TRUE) once all its
+*   non-square shapes have been evaluated
+*******************************************/
+void stash_neighbour_arrays(
     PictureControlSet_t                *picture_control_set_ptr,
     ModeDecisionContext_t               *context_ptr,
-    uint32_t                            src_idx,
-    uint32_t                            dst_idx,
+    EbBool                              restore,
     uint32_t                            blk_mds,
     uint32_t                            sb_org_x,
     uint32_t                            sb_org_y)
 {
-    (void)*context_ptr;
+    uint8_t                            *stash_ptr = context_ptr->md_neighbor_stash;
 
     const BlockGeom * blk_geom = get_blk_geom_mds(blk_mds);
 
@@ -408,72 +415,79 @@ void copy_neighbour_arrays(
     uint32_t                            bwidth_uv = blk_geom->bwidth_uv;
     uint32_t                            bheight_uv = blk_geom->bheight_uv;
 
-    copy_neigh_arr(
-        picture_control_set_ptr->md_intra_luma_mode_neighbor_array[src_idx],
-        picture_control_set_ptr->md_intra_luma_mode_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_intra_luma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_intra_chroma_mode_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_intra_chroma_mode_neighbor_array[src_idx],
-        picture_control_set_ptr->md_intra_chroma_mode_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_intra_chroma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x_uv,
         blk_org_y_uv,
         bwidth_uv,
         bheight_uv,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_skip_flag_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_skip_flag_neighbor_array[src_idx],
-        picture_control_set_ptr->md_skip_flag_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_skip_flag_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_mode_type_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_mode_type_neighbor_array[src_idx],
-        picture_control_set_ptr->md_mode_type_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_mode_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+        restore);
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_leaf_depth_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_leaf_depth_neighbor_array[src_idx],
-        picture_control_set_ptr->md_leaf_depth_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_leaf_depth_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    copy_neigh_arr(
-        picture_control_set_ptr->mdleaf_partition_neighbor_array[src_idx],
-        picture_control_set_ptr->mdleaf_partition_neighbor_array[dst_idx],
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->mdleaf_partition_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_luma_recon_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_luma_recon_neighbor_array[src_idx],
-        picture_control_set_ptr->md_luma_recon_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+        restore);
 
 #if CHROMA_BLIND
     if (blk_geom->has_uv && context_ptr->chroma_level == CHROMA_MODE_0) {
@@ -482,98 +496,107 @@ void copy_neighbour_arrays(
 #endif
         //neighbor_array_unit_reset(picture_control_set_ptr->md_cb_recon_neighbor_array[depth]);
 
-        copy_neigh_arr(
-            picture_control_set_ptr->md_cb_recon_neighbor_array[src_idx],
-            picture_control_set_ptr->md_cb_recon_neighbor_array[dst_idx],
+        stash_ptr += neigh_arr_stash(
+            picture_control_set_ptr->md_cb_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            stash_ptr,
             blk_org_x_uv,
             blk_org_y_uv,
             bwidth_uv,
             bheight_uv,
-            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+            NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+        restore);
 
         //neighbor_array_unit_reset(picture_control_set_ptr->md_cr_recon_neighbor_array[depth]);
-        copy_neigh_arr(
-            picture_control_set_ptr->md_cr_recon_neighbor_array[src_idx],
-            picture_control_set_ptr->md_cr_recon_neighbor_array[dst_idx],
+        stash_ptr += neigh_arr_stash(
+            picture_control_set_ptr->md_cr_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            stash_ptr,
             blk_org_x_uv,
             blk_org_y_uv,
             bwidth_uv,
             bheight_uv,
-            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+            NEIGHBOR_ARRAY_UNIT_FULL_MASK,
+        restore);
 
 
     }
 
     //neighbor_array_unit_reset(picture_control_set_ptr->md_skip_coeff_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_skip_coeff_neighbor_array[src_idx],
-        picture_control_set_ptr->md_skip_coeff_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_skip_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
     //neighbor_array_unit_reset(picture_control_set_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_luma_dc_sign_level_coeff_neighbor_array[src_idx],
-        picture_control_set_ptr->md_luma_dc_sign_level_coeff_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
 #if CHROMA_BLIND
     if (blk_geom->has_uv && context_ptr->chroma_level == CHROMA_MODE_0) {
 #else
     if (blk_geom->has_uv) {
 #endif
-        copy_neigh_arr(
-            picture_control_set_ptr->md_cb_dc_sign_level_coeff_neighbor_array[src_idx],
-            picture_control_set_ptr->md_cb_dc_sign_level_coeff_neighbor_array[dst_idx],
+        stash_ptr += neigh_arr_stash(
+            picture_control_set_ptr->md_cb_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            stash_ptr,
             blk_org_x_uv,
             blk_org_y_uv,
             bwidth_uv,
             bheight_uv,
-            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
         //neighbor_array_unit_reset(picture_control_set_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth]);
 
-        copy_neigh_arr(
-            picture_control_set_ptr->md_cr_dc_sign_level_coeff_neighbor_array[src_idx],
-            picture_control_set_ptr->md_cr_dc_sign_level_coeff_neighbor_array[dst_idx],
+        stash_ptr += neigh_arr_stash(
+            picture_control_set_ptr->md_cr_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+            stash_ptr,
             blk_org_x_uv,
             blk_org_y_uv,
             bwidth_uv,
             bheight_uv,
-            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+            NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
     }
     //neighbor_array_unit_reset(picture_control_set_ptr->md_inter_pred_dir_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_inter_pred_dir_neighbor_array[src_idx],
-        picture_control_set_ptr->md_inter_pred_dir_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_inter_pred_dir_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
     //neighbor_array_unit_reset(picture_control_set_ptr->md_ref_frame_type_neighbor_array[depth]);
-    copy_neigh_arr(
-        picture_control_set_ptr->md_ref_frame_type_neighbor_array[src_idx],
-        picture_control_set_ptr->md_ref_frame_type_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash(
+        picture_control_set_ptr->md_ref_frame_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 
-    copy_neigh_arr_32(
-        picture_control_set_ptr->md_interpolation_type_neighbor_array[src_idx],
-        picture_control_set_ptr->md_interpolation_type_neighbor_array[dst_idx],
+    stash_ptr += neigh_arr_stash_32(
+        picture_control_set_ptr->md_interpolation_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX],
+        stash_ptr,
         blk_org_x,
         blk_org_y,
         blk_geom->bwidth,
         blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK,
+        restore);
 }
 
 void md_update_all_neighbour_arrays(
@@ -1485,6 +1508,7 @@ void ProductPerformFastLoop(
     {
         candidateBuffer = candidateBufferPtrArrayBase[highestCostIndex];
         ModeDecisionCandidate_t *const  candidate_ptr = candidateBuffer->candidate_ptr = &fast_candidate_array[fastLoopCandidateIndex];
+        context_ptr->candidate_type_array[highestCostIndex] = (uint8_t)candidate_ptr->type;
                   
 #if TWO_FAST_LOOP 
         const unsigned                  enable_two_fast_loops = candidate_ptr->enable_two_fast_loops;
@@ -1633,33 +1657,23 @@ void ProductPerformFastLoop(
             (*secondFastCostSearchCandidateTotalCount)++;
         }
 
-        // Find the buffer with the highest cost
+        // Find the buffer with the highest cost: a branchless max reduction over
+        // the contiguous costs, then the first buffer holding it (an unused buffer
+        // holds the max cost)
         if (fastLoopCandidateIndex)
         {
-            // maxCost is volatile to prevent the compiler from loading 0xFFFFFFFFFFFFFF
-            //   as a const at the early-out. Loading a large constant on intel x64 processors
-            //   clogs the i-cache/intstruction decode. This still reloads the variable from
-            //   the stack each pass, so a better solution would be to register the variable,
-            //   but this might require asm.
-
-            volatile uint64_t maxCost = ~0ull;
             const uint64_t *fast_cost_array = context_ptr->fast_cost_array;
             const uint32_t bufferIndexStart = context_ptr->buffer_depth_index_start[0];
             const uint32_t bufferIndexEnd = bufferIndexStart + maxBuffers;
             uint32_t bufferIndex;
 
-            highestCostIndex = bufferIndexStart;
-            bufferIndex = bufferIndexStart + 1;
-
-            do {
-                highestCost = fast_cost_array[highestCostIndex];
-                if (highestCost == maxCost)
-                    break;
-
-                if (fast_cost_array[bufferIndex] > highestCost)
-                    highestCostIndex = bufferIndex;
+            highestCost = fast_cost_array[bufferIndexStart];
+            for (bufferIndex = bufferIndexStart + 1; bufferIndex < bufferIndexEnd; ++bufferIndex)
+                highestCost = MAX(highestCost, fast_cost_array[bufferIndex]);
 
-            } while (++bufferIndex < bufferIndexEnd);
+            highestCostIndex = bufferIndexStart;
+            while (fast_cost_array[highestCostIndex] != highestCost)
+                highestCostIndex++;
         }
     } while (--fastLoopCandidateIndex >= 0);// End Second FastLoop
 
@@ -2097,6 +2111,7 @@ static void CflPrediction(
 
 
     // 3: Loop over alphas and find the best or choose DC
+    MD_PROFILER_START(cfl_start);
     cfl_rd_pick_alpha(
         picture_control_set_ptr,
         candidateBuffer,
@@ -2106,6 +2121,7 @@ static void CflPrediction(
         inputCbOriginIndex,
         cuChromaOriginIndex,
         asm_type);
+    MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_CFL, context_ptr->blk_geom->bsize, cfl_start);
 
 
     if (candidateBuffer->candidate_ptr->intra_chroma_mode == UV_CFL_PRED) {
@@ -2342,10 +2358,12 @@ void AV1PerformFullLoop(
 #endif
         if (!tx_search_skip_fag){
 
+                MD_PROFILER_START(tx_search_start);
                 ProductFullLoopTxSearch(
                     candidateBuffer,
                     context_ptr,
                     picture_control_set_ptr);
+                MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_TX_SEARCH, context_ptr->blk_geom->bsize, tx_search_start);
 
             candidate_ptr->full_distortion = 0;
 
@@ -2713,11 +2731,13 @@ void inter_depth_tx_search(
             count_non_zero_coeffs);
 
 
+        MD_PROFILER_START(tx_search_start);
         ProductFullLoopTxSearch(
             candidateBuffer,
             context_ptr,
             picture_control_set_ptr
         );
+        MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_TX_SEARCH, context_ptr->blk_geom->bsize, tx_search_start);
 
 
         candidate_ptr->full_distortion = 0;
@@ -3006,6 +3026,10 @@ void md_encode_block(
     CodingUnit_t *  cu_ptr = context_ptr->cu_ptr;
     candidate_buffer_ptr_array = &(candidateBufferPtrArrayBase[context_ptr->buffer_depth_index_start[0]]);
 
+    // The intra edges are built by the first intra candidate of the block
+    for (uint32_t plane = 0; plane < MAX_MB_PLANE; ++plane)
+        context_ptr->intra_edge_cache[plane].valid = EB_FALSE;
+
     if (allowed_ns_cu(
 #if DISABLE_NSQ_FOR_NON_REF || DISABLE_NSQ
         context_ptr, sequence_control_set_ptr->sb_geom[lcuAddr].is_complete_sb))
@@ -3058,6 +3082,7 @@ void md_encode_block(
         //if we want to recon N candidate, we would need N+1 buffers
         maxBuffers = MIN((buffer_total_count + 1), context_ptr->buffer_depth_index_width[0]);
 
+        MD_PROFILER_START(fast_loop_start);
         ProductPerformFastLoop(
             picture_control_set_ptr,
             context_ptr->sb_ptr,
@@ -3075,6 +3100,7 @@ void md_encode_block(
             maxBuffers,
             &secondFastCostSearchCandidateTotalCount,
             asm_type);
+        MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_FAST_LOOP, context_ptr->blk_geom->bsize, fast_loop_start);
 
         // Make sure buffer_total_count is not larger than the number of fast modes
         buffer_total_count = MIN(secondFastCostSearchCandidateTotalCount, buffer_total_count);
@@ -3088,7 +3114,8 @@ void md_encode_block(
         PreModeDecision(
             cu_ptr,
             (secondFastCostSearchCandidateTotalCount == buffer_total_count) ? buffer_total_count : maxBuffers,
-            candidate_buffer_ptr_array,
+            context_ptr->fast_cost_array + context_ptr->buffer_depth_index_start[0],
+            context_ptr->candidate_type_array + context_ptr->buffer_depth_index_start[0],
             &fullCandidateTotalCount,
             context_ptr->best_candidate_index_array,
 #if USED_NFL_FEATURE_BASED
@@ -3099,6 +3126,7 @@ void md_encode_block(
             (EbBool)(secondFastCostSearchCandidateTotalCount == buffer_total_count)); // The fast loop bug fix is now added to 4K only
 
 
+        MD_PROFILER_START(full_loop_start);
         AV1PerformFullLoop(
             picture_control_set_ptr,
             context_ptr->sb_ptr,
@@ -3112,6 +3140,7 @@ void md_encode_block(
             MIN(fullCandidateTotalCount, buffer_total_count),
             ref_fast_cost,
             asm_type); // fullCandidateTotalCount to number of buffers to process
+        MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_FULL_LOOP, context_ptr->blk_geom->bsize, full_loop_start);
 
         // Full Mode Decision (choose the best mode)
         candidateIndex = product_full_mode_decision(
@@ -3382,20 +3411,20 @@ EB_EXTERN EbErrorType mode_decision_sb(
             if (leafDataPtr->tot_d1_blocks != 1)
             {
                 if (blk_geom->shape == PART_N)
-                    copy_neighbour_arrays(      //save a clean neigh in [1], encode uses [0], reload the clean in [0] after done last ns block in a partition
+                    stash_neighbour_arrays(      //save a clean neigh in the SB-local stash, encode uses [0], reload the clean in [0] after done last ns block in a partition
                         picture_control_set_ptr,
                         context_ptr,
-                        0, 1,
+                        EB_FALSE,
                         blk_idx_mds,
                         sb_origin_x,
                         sb_origin_y);
             }
 #else
         if (blk_geom->shape == PART_N)
-            copy_neighbour_arrays(      //save a clean neigh in [1], encode uses [0], reload the clean in [0] after done last ns block in a partition
+            stash_neighbour_arrays(      //save a clean neigh in the SB-local stash, encode uses [0], reload the clean in [0] after done last ns block in a partition
                 picture_control_set_ptr,
                 context_ptr,
-                0, 1,
+                EB_FALSE,
                 blk_idx_mds,
                 sb_origin_x,
                 sb_origin_y);
@@ -3422,10 +3451,10 @@ EB_EXTERN EbErrorType mode_decision_sb(
                     sb_origin_x,
                     sb_origin_y);
             else
-                copy_neighbour_arrays(      //restore [1] in [0] after done last ns block
+                stash_neighbour_arrays(      //restore the stash in [0] after done last ns block
                     picture_control_set_ptr,
                     context_ptr,
-                    1, 0,
+                    EB_TRUE,
                     blk_geom->sqi_mds,
                     sb_origin_x,
                     sb_origin_y);
@@ -3438,6 +3467,7 @@ EB_EXTERN EbErrorType mode_decision_sb(
         if (d1_blocks_accumlated == leafDataPtr->tot_d1_blocks)
         {
 
+            MD_PROFILER_START(inter_depth_start);
             uint32_t  lastCuIndex_mds = d2_inter_depth_block_decision(
                 context_ptr,
                 blk_geom->sqi_mds,//input is parent square
@@ -3448,6 +3478,7 @@ EB_EXTERN EbErrorType mode_decision_sb(
                 context_ptr->full_lambda,
                 context_ptr->md_rate_estimation_ptr,
                 picture_control_set_ptr);
+            MD_PROFILER_STOP(context_ptr, picture_control_set_ptr->enc_mode, MD_PROFILER_INTER_DEPTH, get_blk_geom_mds(blk_geom->sqi_mds)->bsize, inter_depth_start);
 
 
             if (context_ptr->md_cu_arr_nsq[lastCuIndex_mds].split_flag == EB_FALSE)
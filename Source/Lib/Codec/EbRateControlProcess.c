@@ -27,6 +27,7 @@
 #include "EbRateControlResults.h"
 #include "EbRateControlTasks.h"
 #include "RateControlModel.h"
+#include "RateControlTwoPass.h"
 
 
 static uint8_t QP_OFFSET_LAYER_ARRAY[MAX_TEMPORAL_LAYERS] =
@@ -1393,6 +1394,12 @@ void* rate_control_kernel(void *input_ptr){
             if (picture_control_set_ptr->picture_number == 0) {
 
                 rate_control_model_init(rc_model_ptr, sequence_control_set_ptr);
+                // Without a plan the second pass falls back to the single pass rate control
+                if (sequence_control_set_ptr->static_config.pass == 2 &&
+                    two_pass_plan_init(rc_model_ptr, sequence_control_set_ptr) != EB_ErrorNone) {
+                    rc_model_ptr->two_pass = EB_FALSE;
+                    SVT_LOG("SVT [two pass]: no bit allocation plan, single pass rate control used\n");
+                }
                 context_ptr->highLevelRateControlPtr->target_bit_rate = sequence_control_set_ptr->static_config.target_bit_rate;
                 context_ptr->highLevelRateControlPtr->frame_rate = sequence_control_set_ptr->frame_rate;
                 context_ptr->highLevelRateControlPtr->channelBitRatePerFrame = (uint64_t)MAX((int64_t)1, (int64_t)((context_ptr->highLevelRateControlPtr->target_bit_rate << RC_PRECISION) / context_ptr->highLevelRateControlPtr->frame_rate));
@@ -1434,7 +1441,29 @@ void* rate_control_kernel(void *input_ptr){
                 context_ptr->baseLayerFramesAvgQp = sequence_control_set_ptr->qp;
                 context_ptr->baseLayerIntraFramesAvgQp = sequence_control_set_ptr->qp;
             }
-            if (sequence_control_set_ptr->static_config.rate_control_mode)
+            else if (sequence_control_set_ptr->static_config.rate_control_mode &&
+                picture_control_set_ptr->parent_pcs_ptr->target_bit_rate != context_ptr->highLevelRateControlPtr->target_bit_rate) {
+                // Target bit rate updated at runtime: rescale the sliding window budget
+                //   and the virtual buffer, keeping the buffer fullness ratio
+                uint64_t previousVirtualBufferSize = context_ptr->virtualBufferSize;
+                rate_control_model_set_bitrate(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr->target_bit_rate);
+                context_ptr->highLevelRateControlPtr->target_bit_rate = picture_control_set_ptr->parent_pcs_ptr->target_bit_rate;
+                context_ptr->highLevelRateControlPtr->channelBitRatePerFrame = (uint64_t)MAX((int64_t)1, (int64_t)((context_ptr->highLevelRateControlPtr->target_bit_rate << RC_PRECISION) / context_ptr->highLevelRateControlPtr->frame_rate));
+                context_ptr->highLevelRateControlPtr->channelBitRatePerSw = context_ptr->highLevelRateControlPtr->channelBitRatePerFrame * (sequence_control_set_ptr->static_config.look_ahead_distance + 1);
+                context_ptr->highLevelRateControlPtr->bitConstraintPerSw = context_ptr->highLevelRateControlPtr->channelBitRatePerSw;
+#if RC_UPDATE_TARGET_RATE
+                context_ptr->highLevelRateControlPtr->previousUpdatedBitConstraintPerSw = context_ptr->highLevelRateControlPtr->channelBitRatePerSw;
+#endif
+                context_ptr->virtualBufferSize = (((uint64_t)context_ptr->highLevelRateControlPtr->target_bit_rate * 3) << RC_PRECISION) / (context_ptr->frame_rate);
+                context_ptr->virtualBufferLevelInitialValue = context_ptr->virtualBufferSize >> 1;
+                context_ptr->virtualBufferLevel = (int64_t)((context_ptr->virtualBufferLevel * (int64_t)context_ptr->virtualBufferSize) / (int64_t)MAX(1, previousVirtualBufferSize));
+                context_ptr->previousVirtualBufferLevel = context_ptr->virtualBufferLevel;
+                context_ptr->vbFillThreshold1 = (context_ptr->virtualBufferSize * 6) >> 3;
+                context_ptr->vbFillThreshold2 = (context_ptr->virtualBufferSize << 3) >> 3;
+            }
+            // CBR decides from the VBV model alone and the second pass from its plan,
+            // neither needs the look ahead window (a second pass without a plan does)
+            if (sequence_control_set_ptr->static_config.rate_control_mode == 1 && !rc_model_ptr->two_pass)
             {
                 picture_control_set_ptr->parent_pcs_ptr->intra_selected_org_qp = 0;
                 HighLevelRcInputPictureMode2(
@@ -1558,6 +1587,20 @@ void* rate_control_kernel(void *input_ptr){
                 }
                 picture_control_set_ptr->parent_pcs_ptr->picture_qp = picture_control_set_ptr->picture_qp;
             }
+            else if (sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+                // CBR: per frame QP from the VBV buffer model, already within [min_qp_allowed, max_qp_allowed]
+                picture_control_set_ptr->picture_qp = rate_control_get_cbr_quantizer(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr);
+#if NEW_QPS
+                picture_control_set_ptr->parent_pcs_ptr->base_qindex = quantizer_to_qindex[picture_control_set_ptr->picture_qp];
+#endif
+            }
+            else if (rc_model_ptr->two_pass) {
+                // Second pass: planned QP from the first pass statistics, corrected by the drift
+                picture_control_set_ptr->picture_qp = rate_control_get_two_pass_quantizer(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr);
+#if NEW_QPS
+                picture_control_set_ptr->parent_pcs_ptr->base_qindex = quantizer_to_qindex[picture_control_set_ptr->picture_qp];
+#endif
+            }
             else {
                 picture_control_set_ptr->picture_qp = rate_control_get_quantizer(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr);
 
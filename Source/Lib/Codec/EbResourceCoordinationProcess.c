@@ -439,7 +439,23 @@ void* resource_coordination_kernel(void *input_ptr)
         //   prepare a new sequence_control_set_ptr containing the new changes and update the state
         //   of the previous Active SequenceControlSet
         eb_block_on_mutex(context_ptr->sequence_control_set_instance_array[instanceIndex]->config_mutex);
-        if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->initial_picture) {
+
+        // Apply runtime parameter updates on the first picture of a mini-GOP, so
+        //   that all the pictures of a mini-GOP share the same settings (every picture
+        //   starts a mini-GOP of a flat structure)
+        EbBool parameter_update = EB_FALSE;
+        if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->parameter_update_pending &&
+            (sequence_control_set_ptr->static_config.hierarchical_levels == 0 ||
+            (context_ptr->pictureNumberArray[instanceIndex] & ((1 << sequence_control_set_ptr->static_config.hierarchical_levels) - 1)) == 1)) {
+            EncodeContext_t *encode_context_ptr = context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr;
+            sequence_control_set_ptr->static_config.enc_mode = (uint8_t)encode_context_ptr->pending_enc_mode;
+            sequence_control_set_ptr->static_config.target_bit_rate = encode_context_ptr->pending_target_bit_rate;
+            encode_context_ptr->enc_mode = encode_context_ptr->pending_enc_mode;
+            encode_context_ptr->parameter_update_pending = EB_FALSE;
+            parameter_update = EB_TRUE;
+        }
+
+        if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->initial_picture || parameter_update) {
 
             // Update picture width, picture height, cropping right offset, cropping bottom offset, and conformance windows
             if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->initial_picture)
@@ -507,8 +523,9 @@ void* resource_coordination_kernel(void *input_ptr)
         // Set the current SequenceControlSet
         sequence_control_set_ptr = (SequenceControlSet_t*)context_ptr->sequenceControlSetActiveArray[instanceIndex]->object_ptr;
 
-        // Init SB Params
-        if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->initial_picture) {
+        // Init SB Params, again for the fresh SequenceControlSet of a parameter update
+        // (the super block size stays the one the picture pools were built for)
+        if (context_ptr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->initial_picture || parameter_update) {
             derive_input_resolution(
                 sequence_control_set_ptr,
                 input_size);
@@ -653,15 +670,26 @@ void* resource_coordination_kernel(void *input_ptr)
         // Get Empty Output Results Object
         if (picture_control_set_ptr->picture_number > 0 && (prevPictureControlSetWrapperPtr != NULL))
         {
-            ((PictureParentControlSet_t       *)prevPictureControlSetWrapperPtr->object_ptr)->end_of_sequence_flag = end_of_sequence_flag;
-            eb_get_empty_object(
-                context_ptr->resource_coordination_results_output_fifo_ptr,
-                &outputWrapperPtr);
-            outputResultsPtr = (ResourceCoordinationResults_t*)outputWrapperPtr->object_ptr;
-            outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
+            PictureParentControlSet_t *prevPictureControlSetPtr = (PictureParentControlSet_t*)prevPictureControlSetWrapperPtr->object_ptr;
+            uint32_t segment_index;
 
-            // Post the finished Results Object
-            eb_post_full_object(outputWrapperPtr);
+            prevPictureControlSetPtr->end_of_sequence_flag = end_of_sequence_flag;
+
+            // One PA task per SB row segment
+            prevPictureControlSetPtr->pa_segments_total_count = (uint16_t)((SequenceControlSet_t*)prevPictureControlSetPtr->sequence_control_set_wrapper_ptr->object_ptr)->pa_segment_row_count;
+            prevPictureControlSetPtr->pa_segments_completed_count = 0;
+
+            for (segment_index = 0; segment_index < prevPictureControlSetPtr->pa_segments_total_count; ++segment_index) {
+                eb_get_empty_object(
+                    context_ptr->resource_coordination_results_output_fifo_ptr,
+                    &outputWrapperPtr);
+                outputResultsPtr = (ResourceCoordinationResults_t*)outputWrapperPtr->object_ptr;
+                outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
+                outputResultsPtr->segment_index = segment_index;
+
+                // Post the finished Results Object
+                eb_post_full_object(outputWrapperPtr);
+            }
         }
         prevPictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
     }
@@ -16,6 +16,7 @@ extern "C" {
      **************************************/
     typedef struct ResourceCoordinationResults_s {
         EbObjectWrapper_t *pictureControlSetWrapperPtr;
+        uint32_t           segment_index;
     } ResourceCoordinationResults_t;
 
     typedef struct ResourceCoordinationResultInitData_s {
@@ -27,6 +27,7 @@
 
 void ReconOutput(
     PictureControlSet_t    *picture_control_set_ptr,
+    EbObjectWrapper_t      *picture_control_set_wrapper_ptr,
     SequenceControlSet_t   *sequence_control_set_ptr);
 void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame,
     Av1Common *cm, int32_t optimized_lr);
@@ -423,6 +424,7 @@ void* rest_kernel(void *input_ptr)
             if (sequence_control_set_ptr->static_config.recon_enabled) {
                 ReconOutput(
                     picture_control_set_ptr,
+                    cdef_results_ptr->picture_control_set_wrapper_ptr,
                     sequence_control_set_ptr);
             }
 
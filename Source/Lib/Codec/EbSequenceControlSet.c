@@ -55,6 +55,7 @@ EbErrorType eb_sequence_control_set_ctor(
         sequence_control_set_ptr->enc_dec_segment_col_count_array[segment_index] = 1;
         sequence_control_set_ptr->enc_dec_segment_row_count_array[segment_index] = 1;
     }
+    sequence_control_set_ptr->pa_segment_row_count = 1;
 
     // Encode Context
     if (scsInitData != EB_NULL) {
@@ -130,6 +131,7 @@ EbErrorType eb_sequence_control_set_ctor(
     // Initialize SB params
     sb_params_ctor(
         sequence_control_set_ptr);
+    sequence_control_set_ptr->sb_geom = (SbGeom_t*)EB_NULL;
 
     sequence_control_set_ptr->num_bits_width = 16;
     sequence_control_set_ptr->num_bits_height = 16;
@@ -334,6 +336,7 @@ EbErrorType copy_sequence_control_set(
         dst->enc_dec_segment_col_count_array[i] = src->enc_dec_segment_col_count_array[i];
         dst->enc_dec_segment_row_count_array[i] = src->enc_dec_segment_row_count_array[i];
     }
+    dst->pa_segment_row_count = src->pa_segment_row_count;
 
 #if CDEF_M
     dst->cdef_segment_column_count = src->cdef_segment_column_count;
@@ -416,8 +419,8 @@ extern EbErrorType sb_params_init(
     uint16_t    md_scan_block_index;
     uint8_t   pictureLcuWidth = (uint8_t)((sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz);
     uint8_t    pictureLcuHeight = (uint8_t)((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz);
-    EB_MALLOC(SbParams_t*, sequence_control_set_ptr->sb_params_array, sizeof(SbParams_t) * pictureLcuWidth * pictureLcuHeight, EB_N_PTR);
 
+    // sb_params_array is sized for the largest picture at construction
     for (sb_index = 0; sb_index < pictureLcuWidth * pictureLcuHeight; ++sb_index) {
         sequence_control_set_ptr->sb_params_array[sb_index].horizontal_index = (uint8_t)(sb_index % pictureLcuWidth);
         sequence_control_set_ptr->sb_params_array[sb_index].vertical_index = (uint8_t)(sb_index / pictureLcuWidth);
@@ -540,7 +543,10 @@ EbErrorType sb_geom_init(SequenceControlSet_t * sequence_control_set_ptr)
     uint16_t   pictureLcuWidth = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
     uint16_t    pictureLcuHeight = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
 
-    EB_MALLOC(SbGeom_t*, sequence_control_set_ptr->sb_geom, sizeof(SbGeom_t) * pictureLcuWidth * pictureLcuHeight, EB_N_PTR);
+    // Allocated once per SequenceControlSet, the input resolution does not change
+    if (sequence_control_set_ptr->sb_geom == EB_NULL) {
+        EB_MALLOC(SbGeom_t*, sequence_control_set_ptr->sb_geom, sizeof(SbGeom_t) * pictureLcuWidth * pictureLcuHeight, EB_N_PTR);
+    }
 
 
     for (sb_index = 0; sb_index < pictureLcuWidth * pictureLcuHeight; ++sb_index) {
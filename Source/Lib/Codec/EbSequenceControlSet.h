@@ -129,6 +129,7 @@ extern "C" {
         uint32_t                                me_segment_row_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_col_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_row_count_array[MAX_TEMPORAL_LAYERS];
+        uint32_t                                pa_segment_row_count;
 #if CDEF_M
         uint32_t                                cdef_segment_column_count;
         uint32_t                                cdef_segment_row_count;
@@ -7,6 +7,19 @@
 
 #include "EbSystemResourceManager.h"
 
+// Allocation list EB_MALLOC registers into while a SystemResource constructs
+// an object on demand on this thread
+EB_THREAD_LOCAL EbMemoryMapEntry *lazy_memory_map = (EbMemoryMapEntry*)EB_NULL;
+EB_THREAD_LOCAL uint32_t         *lazy_memory_map_index = (uint32_t*)EB_NULL;
+EB_THREAD_LOCAL uint32_t          lazy_memory_map_size = 0;
+EB_THREAD_LOCAL uint64_t         *lazy_total_lib_memory = (uint64_t*)EB_NULL;
+
+// Cores shared by the encoders with a core budget (process wide, not
+// registered in the memory map of an encoder), and the core held by the
+// kernel running on this thread
+static EbHandle core_budget_semaphore = (EbHandle)EB_NULL;
+static EB_THREAD_LOCAL EbHandle core_budget_held = (EbHandle)EB_NULL;
+
 /**************************************
  * EbFifoCtor
  **************************************/
@@ -202,6 +215,7 @@ static EbErrorType EbMuxingQueueCtor(
     *queueDblPtr = queuePtr;
 
     queuePtr->processTotalCount = processTotalCount;
+    queuePtr->resourcePtr = (struct EbSystemResource_s *)EB_NULL;
 
     // Lockout Mutex
     EB_CREATEMUTEX(EbHandle, queuePtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
@@ -442,8 +456,40 @@ EbErrorType eb_system_resource_ctor(
     EbBool              full_fifo_enabled,
     EB_CTOR              object_ctor,
     EbPtr               object_init_data_ptr)
+{
+    return eb_system_resource_lazy_ctor(
+        resource_dbl_ptr,
+        object_total_count,
+        object_total_count,
+        producer_process_total_count,
+        consumer_process_total_count,
+        producer_fifo_ptr_array_ptr,
+        consumer_fifo_ptr_array_ptr,
+        full_fifo_enabled,
+        object_ctor,
+        object_init_data_ptr);
+}
+
+/*********************************************************************
+ * eb_system_resource_lazy_ctor
+ *   Constructor for EbSystemResource constructing only the first
+ *   initial_object_count objects. The other objects are constructed
+ *   on demand by eb_get_empty_object.
+ *********************************************************************/
+EbErrorType eb_system_resource_lazy_ctor(
+    EbSystemResource_t **resource_dbl_ptr,
+    uint32_t               object_total_count,
+    uint32_t               initial_object_count,
+    uint32_t               producer_process_total_count,
+    uint32_t               consumer_process_total_count,
+    EbFifo_t          ***producer_fifo_ptr_array_ptr,
+    EbFifo_t          ***consumer_fifo_ptr_array_ptr,
+    EbBool              full_fifo_enabled,
+    EB_CTOR              object_ctor,
+    EbPtr               object_init_data_ptr)
 {
     uint32_t wrapperIndex;
+    uint32_t object_map_entry_count = 0;
     EbErrorType return_error = EB_ErrorNone;
     // Allocate the System Resource
     EbSystemResource_t *resource_ptr;
@@ -452,6 +498,17 @@ EbErrorType eb_system_resource_ctor(
     *resource_dbl_ptr = resource_ptr;
 
     resource_ptr->object_total_count = object_total_count;
+    resource_ptr->object_constructed_count = object_total_count;
+    if (object_ctor && initial_object_count < object_total_count)
+        resource_ptr->object_constructed_count = initial_object_count ? initial_object_count : 1;
+    resource_ptr->object_ctor = object_ctor;
+    resource_ptr->object_init_data_ptr = object_init_data_ptr;
+    resource_ptr->lazy_memory_map = (EbMemoryMapEntry*)EB_NULL;
+    resource_ptr->lazy_memory_map_index = 0;
+    resource_ptr->lazy_memory_map_size = 0;
+    resource_ptr->lazy_total_lib_memory = 0;
+    resource_ptr->lazy_ctor_mutex = (EbHandle)EB_NULL;
+    resource_ptr->core_budget = (EbHandle)EB_NULL;
 
     // Allocate array for wrapper pointers
     EB_MALLOC(EbObjectWrapper_t**, resource_ptr->wrapperPtrPool, sizeof(EbObjectWrapper_t*) * resource_ptr->object_total_count, EB_N_PTR);
@@ -462,15 +519,36 @@ EbErrorType eb_system_resource_ctor(
         resource_ptr->wrapperPtrPool[wrapperIndex]->liveCount = 0;
         resource_ptr->wrapperPtrPool[wrapperIndex]->releaseEnable = EB_TRUE;
         resource_ptr->wrapperPtrPool[wrapperIndex]->systemResourcePtr = resource_ptr;
+        resource_ptr->wrapperPtrPool[wrapperIndex]->object_ptr = EB_NULL;
 
         // Call the Constructor for each element
-        if (object_ctor) {
+        if (object_ctor && wrapperIndex < resource_ptr->object_constructed_count) {
+            if (wrapperIndex == 0)
+                object_map_entry_count = *memory_map_index;
             return_error = object_ctor(
                 &resource_ptr->wrapperPtrPool[wrapperIndex]->object_ptr,
                 object_init_data_ptr);
             if (return_error == EB_ErrorInsufficientResources) {
                 return EB_ErrorInsufficientResources;
             }
+            if (wrapperIndex == 0)
+                object_map_entry_count = *memory_map_index - object_map_entry_count;
+        }
+    }
+
+    // The objects constructed on demand go into an allocation list of their
+    // own, sized from the allocations of the first object, as kernel threads
+    // of any encoder instance may construct them
+    if (resource_ptr->object_constructed_count < resource_ptr->object_total_count) {
+        resource_ptr->lazy_memory_map_size = object_map_entry_count * (resource_ptr->object_total_count - resource_ptr->object_constructed_count) + 1;
+        EB_MALLOC(EbMemoryMapEntry*, resource_ptr->lazy_memory_map, sizeof(EbMemoryMapEntry) * resource_ptr->lazy_memory_map_size, EB_N_PTR);
+        EB_CREATEMUTEX(EbHandle, resource_ptr->lazy_ctor_mutex, sizeof(EbHandle), EB_MUTEX);
+
+        // Released before the list itself, the memory map being released in reverse order
+        memory_map[*(memory_map_index)].ptrType = EB_LAZY_OBJECTS;
+        memory_map[(*(memory_map_index))++].ptr = resource_ptr;
+        if (*(memory_map_index) >= MAX_NUM_PTR) {
+            return EB_ErrorInsufficientResources;
         }
     }
 
@@ -483,8 +561,10 @@ EbErrorType eb_system_resource_ctor(
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapperIndex = 0; wrapperIndex < resource_ptr->object_total_count; ++wrapperIndex) {
+    resource_ptr->emptyQueue->resourcePtr = resource_ptr;
+
+    // Fill the Empty Fifo with every constructed ObjectWrapper
+    for (wrapperIndex = 0; wrapperIndex < resource_ptr->object_constructed_count; ++wrapperIndex) {
         EbMuxingQueueObjectPushBack(
             resource_ptr->emptyQueue,
             resource_ptr->wrapperPtrPool[wrapperIndex]);
@@ -562,6 +642,46 @@ EbErrorType eb_post_full_object(
     return return_error;
 }
 
+/*********************************************************************
+ * EbSystemResourcePostObjects
+ *   Queues count full EbObjectWrappers of the same SystemResource, in
+ *   order. The objects are assigned to the consumer fifos once all of
+ *   them are queued, under a single fullFifo lockoutMutex round-trip.
+ *
+ *   wrapper_array
+ *      Array of the EbObjectWrapper pointers to be posted.
+ *
+ *   count
+ *      Number of EbObjectWrappers to be posted.
+ *********************************************************************/
+EbErrorType eb_post_full_objects(
+    EbObjectWrapper_t **wrapper_array,
+    uint32_t            count)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    EbMuxingQueue_t *queuePtr;
+    uint32_t index;
+
+    if (count == 0)
+        return return_error;
+
+    queuePtr = wrapper_array[0]->systemResourcePtr->fullQueue;
+
+    eb_block_on_mutex(queuePtr->lockoutMutex);
+
+    for (index = 0; index < count; ++index) {
+        EbCircularBufferPushBack(
+            queuePtr->objectQueue,
+            wrapper_array[index]);
+    }
+
+    EbMuxingQueueAssignation(queuePtr);
+
+    eb_release_mutex(queuePtr->lockoutMutex);
+
+    return return_error;
+}
+
 /*********************************************************************
  * EbSystemResourceReleaseObject
  *   Queues an empty EbObjectWrapper to the SystemResource. This
@@ -598,6 +718,111 @@ EbErrorType eb_release_object(
     return return_error;
 }
 
+/*********************************************************************
+ * EbSystemResourceGrow
+ *   Constructs the next object of a lazily constructed SystemResource
+ *   and queues it as empty, if no empty object is available for the
+ *   requesting producer.
+ *********************************************************************/
+static EbErrorType EbSystemResourceGrow(
+    EbSystemResource_t *resource_ptr,
+    EbFifo_t           *empty_fifo_ptr,
+    EbBool             *grown)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    EbObjectWrapper_t *wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+
+    *grown = EB_FALSE;
+
+    // Reserve the next wrapper
+    eb_block_on_mutex(resource_ptr->emptyQueue->lockoutMutex);
+    if (resource_ptr->object_constructed_count < resource_ptr->object_total_count &&
+        EbCircularBufferEmptyCheck(resource_ptr->emptyQueue->objectQueue) == EB_TRUE &&
+        empty_fifo_ptr->firstPtr == (EbObjectWrapper_t*)EB_NULL) {
+        wrapper_ptr = resource_ptr->wrapperPtrPool[resource_ptr->object_constructed_count++];
+    }
+    eb_release_mutex(resource_ptr->emptyQueue->lockoutMutex);
+
+    if (wrapper_ptr == (EbObjectWrapper_t*)EB_NULL)
+        return return_error;
+
+    // Construct the object into the allocation list of the resource: EB_MALLOC
+    // registers into it on this thread only
+    eb_block_on_mutex(resource_ptr->lazy_ctor_mutex);
+    if (resource_ptr->lazy_memory_map_index < resource_ptr->lazy_memory_map_size) {
+        lazy_memory_map = resource_ptr->lazy_memory_map;
+        lazy_memory_map_index = &resource_ptr->lazy_memory_map_index;
+        lazy_memory_map_size = resource_ptr->lazy_memory_map_size;
+        lazy_total_lib_memory = &resource_ptr->lazy_total_lib_memory;
+
+        return_error = resource_ptr->object_ctor(
+            &wrapper_ptr->object_ptr,
+            resource_ptr->object_init_data_ptr);
+
+        lazy_memory_map = (EbMemoryMapEntry*)EB_NULL;
+        lazy_memory_map_index = (uint32_t*)EB_NULL;
+        lazy_memory_map_size = 0;
+        lazy_total_lib_memory = (uint64_t*)EB_NULL;
+    }
+    else
+        return_error = EB_ErrorInsufficientResources;
+    eb_release_mutex(resource_ptr->lazy_ctor_mutex);
+
+    // On failure the pool stops growing and the producer keeps waiting for a
+    // recycled object
+    if (return_error != EB_ErrorNone) {
+        eb_block_on_mutex(resource_ptr->emptyQueue->lockoutMutex);
+        resource_ptr->object_total_count = resource_ptr->object_constructed_count;
+        eb_release_mutex(resource_ptr->emptyQueue->lockoutMutex);
+        return return_error;
+    }
+
+    eb_block_on_mutex(resource_ptr->emptyQueue->lockoutMutex);
+    wrapper_ptr->liveCount = EB_ObjectWrapperReleasedValue;
+    EbMuxingQueueObjectPushBack(
+        resource_ptr->emptyQueue,
+        wrapper_ptr);
+    eb_release_mutex(resource_ptr->emptyQueue->lockoutMutex);
+    *grown = EB_TRUE;
+
+    return return_error;
+}
+
+/*********************************************************************
+ * eb_system_resource_release_lazy_objects
+ *********************************************************************/
+void eb_system_resource_release_lazy_objects(
+    EbSystemResource_t  *resource_ptr)
+{
+    int32_t ptrIndex;
+    EbMemoryMapEntry *memoryEntry;
+
+    for (ptrIndex = (int32_t)resource_ptr->lazy_memory_map_index - 1; ptrIndex >= 0; --ptrIndex) {
+        memoryEntry = &resource_ptr->lazy_memory_map[ptrIndex];
+        switch (memoryEntry->ptrType) {
+        case EB_N_PTR:
+            free(memoryEntry->ptr);
+            break;
+        case EB_A_PTR:
+#ifdef _WIN32
+            _aligned_free(memoryEntry->ptr);
+#else
+            free(memoryEntry->ptr);
+#endif
+            break;
+        case EB_SEMAPHORE:
+            eb_destroy_semaphore(memoryEntry->ptr);
+            break;
+        case EB_MUTEX:
+            eb_destroy_mutex(memoryEntry->ptr);
+            break;
+        default:
+            break;
+        }
+    }
+    resource_ptr->lazy_memory_map_index = 0;
+}
+
 /*********************************************************************
  * EbSystemResourceGetEmptyObject
  *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
@@ -618,11 +843,20 @@ EbErrorType eb_get_empty_object(
     EbObjectWrapper_t **wrapper_dbl_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbSystemResource_t *resource_ptr = empty_fifo_ptr->queuePtr->resourcePtr;
+    EbHandle core_budget;
+    EbBool grown;
+
+    // Construct a new object rather than waiting when the pool is not complete
+    // yet (checked under the empty queue lock)
+    if (resource_ptr->lazy_memory_map != (EbMemoryMapEntry*)EB_NULL)
+        EbSystemResourceGrow(resource_ptr, empty_fifo_ptr, &grown);
 
     // Queue the Fifo requesting the empty fifo
     EbReleaseProcess(empty_fifo_ptr);
 
-    // Block on the counting Semaphore until an empty buffer is available
+    // Block on the counting Semaphore until an empty buffer is available, without holding a core
+    core_budget = eb_core_budget_suspend();
     eb_block_on_semaphore(empty_fifo_ptr->countingSemaphore);
 
     // Acquire lockout Mutex
@@ -642,6 +876,74 @@ EbErrorType eb_get_empty_object(
     // Release Mutex
     eb_release_mutex(empty_fifo_ptr->lockoutMutex);
 
+    eb_core_budget_resume(core_budget);
+
+    return return_error;
+}
+
+/*********************************************************************
+ * EbSystemResourceGetEmptyObjects
+ *   Dequeues up to count empty EbObjectWrappers from the SystemResource.
+ *   Blocks until the first one is available, as eb_get_empty_object,
+ *   then takes the empty EbObjectWrappers left in the empty queue
+ *   directly: the queue only holds objects when no producer fifo is
+ *   waiting for one. Objects of a lazily constructed SystemResource
+ *   are constructed as needed.
+ *
+ *   wrapper_array
+ *      Array receiving the empty EbObjectWrapper pointers.
+ *
+ *   count
+ *      Size of wrapper_array, at least 1.
+ *
+ *   dequeued_count
+ *      Number of EbObjectWrappers dequeued, at least 1.
+ *********************************************************************/
+EbErrorType eb_get_empty_objects(
+    EbFifo_t           *empty_fifo_ptr,
+    EbObjectWrapper_t **wrapper_array,
+    uint32_t            count,
+    uint32_t           *dequeued_count)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    EbSystemResource_t *resource_ptr = empty_fifo_ptr->queuePtr->resourcePtr;
+    EbMuxingQueue_t *queuePtr = resource_ptr->emptyQueue;
+    EbObjectWrapper_t *wrapper_ptr;
+    EbBool complete;
+    EbBool grown;
+    uint32_t index = 1;
+
+    // Block until the first object is available
+    return_error = eb_get_empty_object(
+        empty_fifo_ptr,
+        &wrapper_array[0]);
+
+    while (index < count) {
+
+        // Take the objects already queued
+        eb_block_on_mutex(queuePtr->lockoutMutex);
+        while (index < count && EbCircularBufferEmptyCheck(queuePtr->objectQueue) == EB_FALSE) {
+            EbCircularBufferPopFront(
+                queuePtr->objectQueue,
+                (void **)&wrapper_ptr);
+
+            wrapper_ptr->liveCount = 0;
+            wrapper_ptr->releaseEnable = EB_TRUE;
+            wrapper_array[index++] = wrapper_ptr;
+        }
+        complete = resource_ptr->object_constructed_count >= resource_ptr->object_total_count ? EB_TRUE : EB_FALSE;
+        eb_release_mutex(queuePtr->lockoutMutex);
+
+        if (index == count || complete)
+            break;
+
+        // Construct the next object of a lazily constructed SystemResource
+        if (EbSystemResourceGrow(resource_ptr, empty_fifo_ptr, &grown) != EB_ErrorNone || grown == EB_FALSE)
+            break;
+    }
+
+    *dequeued_count = index;
+
     return return_error;
 }
 
@@ -669,6 +971,9 @@ EbErrorType eb_get_full_object(
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(full_fifo_ptr);
 
+    // The previous task is over: give its core back while waiting
+    eb_core_budget_suspend();
+
     // Block on the counting Semaphore until an empty buffer is available
     eb_block_on_semaphore(full_fifo_ptr->countingSemaphore);
 
@@ -682,6 +987,9 @@ EbErrorType eb_get_full_object(
     // Release Mutex
     eb_release_mutex(full_fifo_ptr->lockoutMutex);
 
+    // Process the task on a core of the budget
+    eb_core_budget_resume((*wrapper_dbl_ptr)->systemResourcePtr->core_budget);
+
     return return_error;
 }
 
@@ -728,4 +1036,43 @@ EbErrorType eb_get_full_object_non_blocking(
         *wrapper_dbl_ptr = (EbObjectWrapper_t*)EB_NULL;
 
     return return_error;
-}
\ No newline at end of file
+}
+
+/*********************************************************************
+ * eb_core_budget_ctor
+ *********************************************************************/
+EbHandle eb_core_budget_ctor(
+    uint32_t core_count)
+{
+    if (core_budget_semaphore == (EbHandle)EB_NULL)
+        core_budget_semaphore = eb_create_semaphore(core_count, core_count);
+
+    return core_budget_semaphore;
+}
+
+/*********************************************************************
+ * eb_core_budget_suspend
+ *********************************************************************/
+EbHandle eb_core_budget_suspend(void)
+{
+    EbHandle core_budget = core_budget_held;
+
+    if (core_budget != (EbHandle)EB_NULL) {
+        core_budget_held = (EbHandle)EB_NULL;
+        eb_post_semaphore(core_budget);
+    }
+
+    return core_budget;
+}
+
+/*********************************************************************
+ * eb_core_budget_resume
+ *********************************************************************/
+void eb_core_budget_resume(
+    EbHandle core_budget)
+{
+    if (core_budget != (EbHandle)EB_NULL) {
+        eb_block_on_semaphore(core_budget);
+        core_budget_held = core_budget;
+    }
+}
@@ -98,6 +98,9 @@ extern "C" {
         uint32_t              processTotalCount;
         EbFifo_t          **processFifoPtrArray;
 
+        // resourcePtr - the SystemResource the queue belongs to
+        struct EbSystemResource_s *resourcePtr;
+
     } EbMuxingQueue_t;
 
     /*********************************************************************
@@ -126,6 +129,28 @@ extern "C" {
         //EbFifo_t           *fullFifo;
         EbMuxingQueue_t     *fullQueue;
 
+        // object_constructed_count - A count of the objects constructed so far.
+        //   Lower than object_total_count for lazily constructed resources; the
+        //   remaining objects are constructed on demand by eb_get_empty_object.
+        uint32_t              object_constructed_count;
+        EB_CTOR               object_ctor;
+        EbPtr                 object_init_data_ptr;
+
+        // Allocation list of the objects constructed on demand, sized from the
+        //   allocations of the first object, and the mutex serializing their
+        //   construction. Released with the memory map of the encoder
+        //   (EB_LAZY_OBJECTS entry).
+        EbMemoryMapEntry     *lazy_memory_map;
+        uint32_t              lazy_memory_map_index;
+        uint32_t              lazy_memory_map_size;
+        uint64_t              lazy_total_lib_memory;
+        EbHandle              lazy_ctor_mutex;
+
+        // core_budget - Semaphore of the cores shared by the encoders with a
+        //   core budget, EB_NULL otherwise. A kernel dequeuing a full object
+        //   of the resource holds one of these cores until it blocks again.
+        EbHandle              core_budget;
+
     } EbSystemResource_t;
 
     /*********************************************************************
@@ -221,6 +246,40 @@ extern "C" {
         EB_CTOR             object_ctor,
         EbPtr               object_init_data_ptr);
 
+    /*********************************************************************
+     * eb_system_resource_lazy_ctor
+     *   Same as eb_system_resource_ctor, except that only the first
+     *   initial_object_count objects are constructed up front. The
+     *   remaining ones are constructed on first use, when a producer
+     *   finds the empty queue drained, until object_total_count is
+     *   reached. object_init_data_ptr must therefore stay valid for the
+     *   lifetime of the SystemResource.
+     *
+     *   initial_object_count
+     *     Number of objects constructed by the constructor (at least 1).
+     *********************************************************************/
+    extern EbErrorType eb_system_resource_lazy_ctor(
+        EbSystemResource_t **resource_dbl_ptr,
+        uint32_t            object_total_count,
+        uint32_t            initial_object_count,
+        uint32_t            producer_process_total_count,
+        uint32_t            consumer_process_total_count,
+        EbFifo_t         ***producer_fifo_ptr_array_ptr,
+        EbFifo_t         ***consumer_fifo_ptr_array_ptr,
+        EbBool              full_fifo_enabled,
+        EB_CTOR             object_ctor,
+        EbPtr               object_init_data_ptr);
+
+    /*********************************************************************
+     * eb_system_resource_release_lazy_objects
+     *   Releases the allocations of the objects a lazily constructed
+     *   SystemResource constructed on demand. Called for its
+     *   EB_LAZY_OBJECTS entry when the memory map of the encoder is
+     *   released.
+     *********************************************************************/
+    extern void eb_system_resource_release_lazy_objects(
+        EbSystemResource_t  *resource_ptr);
+
     /*********************************************************************
      * eb_system_resource_dtor
      *   Destructor for EbSystemResource.  Fully destructs all members
@@ -259,6 +318,28 @@ extern "C" {
         EbFifo_t           *empty_fifo_ptr,
         EbObjectWrapper_t **wrapper_dbl_ptr);
 
+    /*********************************************************************
+     * EbSystemResourceGetEmptyObjects
+     *   Dequeues up to count empty EbObjectWrappers from the SystemResource.
+     *   Blocks until the first one is available, as eb_get_empty_object,
+     *   then takes the empty EbObjectWrappers already queued without
+     *   waiting for more.
+     *
+     *   wrapper_array
+     *      Array receiving the empty EbObjectWrapper pointers.
+     *
+     *   count
+     *      Size of wrapper_array, at least 1.
+     *
+     *   dequeued_count
+     *      Number of EbObjectWrappers dequeued, at least 1.
+     *********************************************************************/
+    extern EbErrorType eb_get_empty_objects(
+        EbFifo_t           *empty_fifo_ptr,
+        EbObjectWrapper_t **wrapper_array,
+        uint32_t            count,
+        uint32_t           *dequeued_count);
+
     /*********************************************************************
      * EbSystemResourcePostObject
      *   Queues a full EbObjectWrapper to the SystemResource. This
@@ -276,6 +357,21 @@ extern "C" {
     extern EbErrorType eb_post_full_object(
         EbObjectWrapper_t *object_ptr);
 
+    /*********************************************************************
+     * EbSystemResourcePostObjects
+     *   Queues count full EbObjectWrappers of the same SystemResource, in
+     *   order, with a single lockoutMutex round-trip.
+     *
+     *   wrapper_array
+     *      Array of the EbObjectWrapper pointers to be posted.
+     *
+     *   count
+     *      Number of EbObjectWrappers to be posted.
+     *********************************************************************/
+    extern EbErrorType eb_post_full_objects(
+        EbObjectWrapper_t **wrapper_array,
+        uint32_t            count);
+
     /*********************************************************************
      * EbSystemResourceGetFullObject
      *   Dequeues an full EbObjectWrapper from the SystemResource. This
@@ -311,6 +407,27 @@ extern "C" {
      *********************************************************************/
     extern EbErrorType eb_release_object(
         EbObjectWrapper_t *object_ptr);
+
+    /*********************************************************************
+     * eb_core_budget_ctor
+     *   Returns the semaphore of the core budget shared by the encoders of
+     *   the process, created with core_count cores by the first call. It
+     *   lives as long as the process.
+     *********************************************************************/
+    extern EbHandle eb_core_budget_ctor(
+        uint32_t            core_count);
+
+    /*********************************************************************
+     * eb_core_budget_suspend / eb_core_budget_resume
+     *   Gives back the core of the budget held by the calling kernel, if
+     *   any, before it blocks outside of the SystemResource functions, and
+     *   takes one again afterwards. eb_core_budget_suspend returns the
+     *   budget to pass to eb_core_budget_resume.
+     *********************************************************************/
+    extern EbHandle eb_core_budget_suspend(void);
+
+    extern void eb_core_budget_resume(
+        EbHandle            core_budget);
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,39 @@ static uint32_t    get_inter_qp_for_size(EbRateControlModel *model_ptr, uint32_t
  */
 static void record_new_gop(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr);
 
+/*
+ * @private
+ * @function get_frame_class. Frame class used by the CBR model: 0 for intra
+ * frames, 1 + temporal layer index for inter frames
+ * @param {PictureParentControlSet_t*} picture_ptr.
+ * @return {uint32_t}.
+ */
+static uint32_t get_frame_class(PictureParentControlSet_t *picture_ptr);
+
+/*
+ * @private
+ * @function get_reference_size_for_qp. Size in bits predicted by the reference
+ * tables for a frame class and a QP, scaled to the current resolution
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {uint32_t} frame_class.
+ * @param {uint32_t} qp.
+ * @return {double}.
+ */
+static double get_reference_size_for_qp(EbRateControlModel *model_ptr, uint32_t frame_class, uint32_t qp);
+
+/*
+ * Share of the frame budget given to an intra frame in CBR mode
+ */
+#define CBR_INTRA_FRAME_WEIGHT      3.0f
+
+/*
+ * Share of the frame budget given to an inter frame in CBR mode per temporal
+ * layer, before normalization over the mini-gop
+ */
+static const float CBR_INTER_LAYER_WEIGHT[EB_MAX_TEMPORAL_LAYERS] = {
+    1.6f, 1.3f, 1.1f, 1.0f, 0.9f, 0.8f
+};
+
 /*
  * Average size in bits for and intra frame per QP for a 1920x1080 reference video clip
  */
@@ -86,11 +119,83 @@ EbErrorType rate_control_model_init(EbRateControlModel *model_ptr, SequenceContr
     model_ptr->gop_infos = gop_infos;
     model_ptr->intra_period = sequenceControlSetPtr->static_config.intra_period_length;
 
+    model_ptr->cbr = (EbBool)(sequenceControlSetPtr->static_config.rate_control_mode == 2);
+    if (model_ptr->cbr) {
+        uint64_t    frame_rate = sequenceControlSetPtr->frame_rate > 1000 ?
+                                 sequenceControlSetPtr->frame_rate :
+                                 sequenceControlSetPtr->frame_rate << 16;
+        uint32_t    hierarchical_levels = MIN(sequenceControlSetPtr->static_config.hierarchical_levels, EB_MAX_TEMPORAL_LAYERS - 1);
+        float       weight_sum = CBR_INTER_LAYER_WEIGHT[0];
+        uint32_t    layer;
+
+        model_ptr->frame_budget = MAX(1, ((uint64_t)model_ptr->desired_bitrate << 16) / MAX(1, frame_rate));
+        model_ptr->vbv_buffer_size = (int64_t)model_ptr->desired_bitrate * sequenceControlSetPtr->static_config.vbv_buffer_size_ms / 1000;
+        model_ptr->vbv_target_level = (int64_t)model_ptr->desired_bitrate * sequenceControlSetPtr->static_config.vbv_initial_level_ms / 1000;
+        model_ptr->vbv_target_level = MIN(model_ptr->vbv_target_level, model_ptr->vbv_buffer_size);
+        model_ptr->vbv_buffer_level = model_ptr->vbv_target_level;
+
+        // Normalize the layer weights so that a mini-gop costs its frame budgets
+        for (layer = 1; layer <= hierarchical_levels; layer++) {
+            weight_sum += CBR_INTER_LAYER_WEIGHT[layer] * (1 << (layer - 1));
+        }
+        model_ptr->class_weight[0] = CBR_INTRA_FRAME_WEIGHT;
+        for (layer = 0; layer < EB_MAX_TEMPORAL_LAYERS; layer++) {
+            model_ptr->class_weight[1 + layer] = CBR_INTER_LAYER_WEIGHT[layer] * (1 << hierarchical_levels) / weight_sum;
+        }
+        for (layer = 0; layer < 1 + EB_MAX_TEMPORAL_LAYERS; layer++) {
+            model_ptr->size_correction[layer] = 1;
+            model_ptr->last_qp[layer] = -1;
+        }
+    }
+
     return EB_ErrorNone;
 }
 
 EbErrorType    rate_control_update_model(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr) {
     uint64_t                size = picture_ptr->total_num_bits;
+
+    if (model_ptr->cbr) {
+        uint32_t    frame_class = get_frame_class(picture_ptr);
+        double      reference_size = get_reference_size_for_qp(model_ptr, frame_class, picture_ptr->picture_qp);
+        float       variation = (float)CLIP3(0.02, 50.0, (double)size / MAX(1.0, reference_size));
+        uint32_t    class_index;
+
+        model_ptr->total_bytes += size;
+        model_ptr->reported_frames++;
+
+        // Replace the predicted size of the frame by its actual size
+        model_ptr->vbv_buffer_level -= (int64_t)size - (int64_t)picture_ptr->target_bits_rc;
+        if (model_ptr->vbv_buffer_level < 0) {
+            model_ptr->vbv_underflow_count++;
+            model_ptr->vbv_buffer_level = 0;
+        }
+
+        if (model_ptr->class_reported_mask & (1 << frame_class)) {
+            model_ptr->size_correction[frame_class] = 0.7f * model_ptr->size_correction[frame_class] + 0.3f * variation;
+        }
+        else {
+            // First report of an inter class also seeds the inter classes not seen yet
+            for (class_index = frame_class ? 1 : 0; class_index < (frame_class ? 1 + EB_MAX_TEMPORAL_LAYERS : 1); class_index++) {
+                if (!(model_ptr->class_reported_mask & (1 << class_index)))
+                    model_ptr->size_correction[class_index] = variation;
+            }
+            model_ptr->class_reported_mask |= 1 << frame_class;
+        }
+
+        return EB_ErrorNone;
+    }
+
+    if (model_ptr->two_pass) {
+        uint64_t    frame_index = MIN(picture_ptr->picture_number, model_ptr->two_pass_frame_count - 1);
+
+        model_ptr->total_bytes += size;
+        model_ptr->reported_frames++;
+        model_ptr->two_pass_planned_total += model_ptr->two_pass_planned_bits[frame_index];
+        model_ptr->two_pass_actual_total += size;
+
+        return EB_ErrorNone;
+    }
+
     EbRateControlGopInfo    *gop = get_gop_infos(model_ptr->gop_infos, picture_ptr->picture_number);
 
     model_ptr->total_bytes += size;
@@ -128,6 +233,75 @@ uint8_t    rate_control_get_quantizer(EbRateControlModel *model_ptr, PicturePare
     return gop->qp;
 }
 
+uint8_t    rate_control_get_cbr_quantizer(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr) {
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint32_t                min_qp = sequence_control_set_ptr->static_config.min_qp_allowed;
+    uint32_t                max_qp = sequence_control_set_ptr->static_config.max_qp_allowed;
+    uint32_t                frame_class = get_frame_class(picture_ptr);
+    int64_t                 recovery_frames = MAX(1, model_ptr->frame_rate >> 1);
+    int64_t                 target_size;
+    double                  predicted_size;
+    uint32_t                qp;
+
+    // Steer the buffer back to its target level within half a second
+    target_size = (int64_t)(model_ptr->frame_budget * model_ptr->class_weight[frame_class]);
+    target_size += (model_ptr->vbv_buffer_level - model_ptr->vbv_target_level) / recovery_frames;
+
+    // Keep a margin for prediction errors so the frame cannot empty the buffer
+    target_size = MIN(target_size, (model_ptr->vbv_buffer_level * 3) >> 2);
+    target_size = MAX(target_size, (int64_t)(model_ptr->frame_budget >> 4));
+
+    for (qp = min_qp; qp < max_qp; qp++) {
+        if (get_reference_size_for_qp(model_ptr, frame_class, qp) * model_ptr->size_correction[frame_class] <= target_size)
+            break;
+    }
+
+    // Limit the QP swing of a class unless the buffer is close to underflow or overflow
+    if (model_ptr->last_qp[frame_class] >= 0) {
+        int32_t     max_increase = model_ptr->vbv_buffer_level < (model_ptr->vbv_buffer_size >> 2) ? 8 : 4;
+        int32_t     max_decrease = model_ptr->vbv_buffer_level > ((model_ptr->vbv_buffer_size * 7) >> 3) ? 8 : 4;
+
+        qp = (uint32_t)CLIP3(
+            MAX(model_ptr->last_qp[frame_class] - max_decrease, (int32_t)min_qp),
+            MIN(model_ptr->last_qp[frame_class] + max_increase, (int32_t)max_qp),
+            (int32_t)qp);
+    }
+    model_ptr->last_qp[frame_class] = (int32_t)qp;
+
+    // Account the frame with its predicted size until the packetizer reports it
+    predicted_size = get_reference_size_for_qp(model_ptr, frame_class, qp) * model_ptr->size_correction[frame_class];
+    picture_ptr->target_bits_rc = (uint64_t)predicted_size;
+    model_ptr->vbv_buffer_level += (int64_t)model_ptr->frame_budget - (int64_t)picture_ptr->target_bits_rc;
+    model_ptr->vbv_buffer_level = MIN(model_ptr->vbv_buffer_level, model_ptr->vbv_buffer_size);
+
+    return (uint8_t)qp;
+}
+
+void rate_control_model_set_bitrate(EbRateControlModel *model_ptr, uint32_t target_bit_rate) {
+    if (model_ptr->cbr && model_ptr->desired_bitrate) {
+        double      ratio = (double)target_bit_rate / model_ptr->desired_bitrate;
+
+        model_ptr->frame_budget = MAX(1, (uint64_t)(model_ptr->frame_budget * ratio));
+        model_ptr->vbv_buffer_size = (int64_t)(model_ptr->vbv_buffer_size * ratio);
+        model_ptr->vbv_target_level = (int64_t)(model_ptr->vbv_target_level * ratio);
+        model_ptr->vbv_buffer_level = (int64_t)(model_ptr->vbv_buffer_level * ratio);
+    }
+    model_ptr->desired_bitrate = target_bit_rate;
+}
+
+static uint32_t get_frame_class(PictureParentControlSet_t *picture_ptr) {
+    if (picture_ptr->slice_type == I_SLICE)
+        return 0;
+
+    return 1 + MIN(picture_ptr->temporal_layer_index, EB_MAX_TEMPORAL_LAYERS - 1);
+}
+
+static double get_reference_size_for_qp(EbRateControlModel *model_ptr, uint32_t frame_class, uint32_t qp) {
+    const size_t *size_predictions = frame_class ? model_ptr->inter_size_predictions : model_ptr->intra_size_predictions;
+
+    return (double)size_predictions[MIN(qp, MAX_QP_VALUE)] / (1920 * 1080) * model_ptr->pixels;
+}
+
 uint32_t get_inter_qp_for_size(EbRateControlModel *model_ptr, uint32_t desired_size) {
     uint8_t     qp;
     
@@ -83,6 +83,87 @@ typedef struct    RateControlModel_s {
      * Indexed by pictureNumber.
      */
     EbRateControlGopInfo    *gop_infos;
+
+    /*
+     * @variable EbBool. Constant bitrate mode: QP is chosen per frame from the
+     * leaky bucket (VBV) model below instead of per gop
+     */
+    EbBool      cbr;
+
+    /*
+     * @variable uint64_t. Bits added to the VBV buffer per frame interval
+     */
+    uint64_t    frame_budget;
+
+    /*
+     * @variable int64_t. VBV buffer size in bits
+     */
+    int64_t     vbv_buffer_size;
+
+    /*
+     * @variable int64_t. VBV buffer level (decoder buffer fullness) in bits the
+     * model steers towards
+     */
+    int64_t     vbv_target_level;
+
+    /*
+     * @variable int64_t. Current VBV buffer level in bits. Frames still in flight
+     * are accounted with their predicted size until their actual size is reported
+     */
+    int64_t     vbv_buffer_level;
+
+    /*
+     * @variable uint64_t. Number of frames that emptied the VBV buffer
+     */
+    uint64_t    vbv_underflow_count;
+
+    /*
+     * @variable float[]. Ratio between the actual and the predicted frame size,
+     * per frame class. Index 0 is intra, 1 + temporal layer index is inter
+     */
+    float       size_correction[1 + EB_MAX_TEMPORAL_LAYERS];
+
+    /*
+     * @variable float[]. Share of the frame budget given to each frame class
+     */
+    float       class_weight[1 + EB_MAX_TEMPORAL_LAYERS];
+
+    /*
+     * @variable int32_t[]. Last QP used per frame class, -1 when none yet
+     */
+    int32_t     last_qp[1 + EB_MAX_TEMPORAL_LAYERS];
+
+    /*
+     * @variable uint32_t. Bit mask of the frame classes with a reported size
+     */
+    uint32_t    class_reported_mask;
+
+    /*
+     * @variable EbBool. Second pass of a two pass encode: QP is taken from a plan
+     * built on the first pass statistics (RateControlTwoPass.h)
+     */
+    EbBool      two_pass;
+
+    /*
+     * @variable uint32_t. Number of frames in the plan
+     */
+    uint32_t    two_pass_frame_count;
+
+    /*
+     * @variable uint8_t*. Planned QP per frame, in display order
+     */
+    uint8_t     *two_pass_qp;
+
+    /*
+     * @variable uint64_t*. Planned size per frame in bits, in display order
+     */
+    uint64_t    *two_pass_planned_bits;
+
+    /*
+     * @variable int64_t. Planned and actual size of the frames reported so far
+     */
+    int64_t     two_pass_planned_total;
+    int64_t     two_pass_actual_total;
 } EbRateControlModel;
 
 /*
@@ -122,6 +203,29 @@ EbErrorType    rate_control_update_model(EbRateControlModel *model_ptr,
 uint8_t    rate_control_get_quantizer(EbRateControlModel *model_ptr,
                                    PictureParentControlSet_t *picture_ptr);
 
+/*
+ * @function rate_control_get_cbr_quantizer. Return a QP for the given frame in
+ * constant bitrate mode. The frame target is derived from the frame budget and
+ * the distance of the VBV buffer level to its target level, and is capped to
+ * keep the buffer from underflowing. The frame is accounted in the buffer with
+ * its predicted size, stored in target_bits_rc until the actual size is reported.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {PictureParentControlSet_t*} picture_ptr. Frame to be encoded.
+ * @return {uint8_t}. Suggested QP for the given frame
+ */
+uint8_t    rate_control_get_cbr_quantizer(EbRateControlModel *model_ptr,
+                                       PictureParentControlSet_t *picture_ptr);
+
+/*
+ * @function rate_control_model_set_bitrate. Apply a new target bitrate, scaling
+ * the VBV buffer and keeping its fullness ratio.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {uint32_t} target_bit_rate. New target bitrate in bits per second.
+ * @return {void}.
+ */
+void    rate_control_model_set_bitrate(EbRateControlModel *model_ptr,
+                                    uint32_t target_bit_rate);
+
 /*
  * @function get_gop_size_in_bytes. Return the size in bytes a new gop should take
  * to fit closer to the rate control constraints.
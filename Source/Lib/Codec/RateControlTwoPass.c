@@ -0,0 +1,208 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbUtility.h"
+
+#include "RateControlTwoPass.h"
+
+/*
+ * @private
+ * @function get_record_size. Size in bytes of a frame record
+ * @param {uint32_t} sb_count. Number of super blocks per frame.
+ * @return {uint64_t}.
+ */
+static uint64_t get_record_size(uint32_t sb_count) {
+    return sizeof(TwoPassFrameStats) + (uint64_t)sb_count * sizeof(TwoPassSbStats);
+}
+
+/*
+ * @private
+ * @function get_predicted_size. Size of a first pass frame re-coded at another
+ * QP, scaled with the reference size tables of the model
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {TwoPassFrameStats*} frame_stats.
+ * @param {uint32_t} qp.
+ * @return {double}.
+ */
+static double get_predicted_size(EbRateControlModel *model_ptr, TwoPassFrameStats *frame_stats, uint32_t qp) {
+    const size_t *size_predictions = frame_stats->slice_type == I_SLICE ?
+        model_ptr->intra_size_predictions :
+        model_ptr->inter_size_predictions;
+
+    return (double)frame_stats->total_num_bits *
+        (double)size_predictions[MIN(qp, MAX_QP_VALUE)] /
+        (double)MAX(1, size_predictions[MIN(frame_stats->qp, MAX_QP_VALUE)]);
+}
+
+EbErrorType two_pass_stats_ctor(EncodeContext_t *encode_context_ptr, SequenceControlSet_t *sequence_control_set_ptr) {
+    EbSvtAv1EncConfiguration    *config = &sequence_control_set_ptr->static_config;
+    uint32_t                    sb_count = ((config->source_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) *
+                                           ((config->source_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64);
+    TwoPassStatsHeader          *header;
+
+    encode_context_ptr->first_pass_stats_capacity = config->frames_to_be_encoded;
+    EB_MALLOC(uint8_t*, encode_context_ptr->first_pass_stats_buffer, sizeof(TwoPassStatsHeader) + config->frames_to_be_encoded * get_record_size(sb_count), EB_N_PTR);
+
+    header = (TwoPassStatsHeader*)encode_context_ptr->first_pass_stats_buffer;
+    EB_MEMSET(header, 0, sizeof(TwoPassStatsHeader));
+    header->magic = TWO_PASS_STATS_MAGIC;
+    header->version = TWO_PASS_STATS_VERSION;
+    header->sb_count = sb_count;
+    header->width = config->source_width;
+    header->height = config->source_height;
+    header->frame_rate = sequence_control_set_ptr->frame_rate > 1000 ?
+                         sequence_control_set_ptr->frame_rate :
+                         sequence_control_set_ptr->frame_rate << 16;
+    encode_context_ptr->first_pass_stats_size = sizeof(TwoPassStatsHeader);
+
+    return EB_ErrorNone;
+}
+
+void two_pass_record_frame_stats(EncodeContext_t *encode_context_ptr, PictureControlSet_t *picture_control_set_ptr) {
+    PictureParentControlSet_t   *parent_pcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
+    SequenceControlSet_t        *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    TwoPassStatsHeader          *header = (TwoPassStatsHeader*)encode_context_ptr->first_pass_stats_buffer;
+    TwoPassFrameStats           *frame_stats;
+    TwoPassSbStats              *sb_stats;
+    uint32_t                    sb_index;
+
+    if (header == NULL || header->frame_count >= encode_context_ptr->first_pass_stats_capacity)
+        return;
+
+    frame_stats = (TwoPassFrameStats*)(encode_context_ptr->first_pass_stats_buffer + encode_context_ptr->first_pass_stats_size);
+    sb_stats = (TwoPassSbStats*)(frame_stats + 1);
+    EB_MEMSET(frame_stats, 0, get_record_size(header->sb_count));
+
+    frame_stats->picture_number = parent_pcs_ptr->picture_number;
+    frame_stats->total_num_bits = parent_pcs_ptr->total_num_bits;
+    frame_stats->pic_avg_variance = parent_pcs_ptr->pic_avg_variance;
+    frame_stats->non_moving_index_average = parent_pcs_ptr->non_moving_index_average;
+    frame_stats->slice_type = (uint8_t)parent_pcs_ptr->slice_type;
+    frame_stats->temporal_layer_index = parent_pcs_ptr->temporal_layer_index;
+    frame_stats->qp = (uint8_t)parent_pcs_ptr->picture_qp;
+    frame_stats->scene_change_flag = (uint8_t)parent_pcs_ptr->scene_change_flag;
+    // Reference frames hold the percentage already (CopyStatisticsToRefObject), others the area
+    frame_stats->intra_coded_area = (uint8_t)(parent_pcs_ptr->is_used_as_reference_flag ?
+        picture_control_set_ptr->intra_coded_area :
+        (picture_control_set_ptr->slice_type == I_SLICE ? 0 :
+            (100 * (uint64_t)picture_control_set_ptr->intra_coded_area) / (sequence_control_set_ptr->luma_width * sequence_control_set_ptr->luma_height)));
+
+    for (sb_index = 0; sb_index < MIN(header->sb_count, parent_pcs_ptr->sb_total_count); ++sb_index) {
+        uint32_t me_distortion = parent_pcs_ptr->slice_type == I_SLICE ? 0 : parent_pcs_ptr->rc_me_distortion[sb_index];
+
+        frame_stats->me_distortion += me_distortion;
+        sb_stats[sb_index].me_distortion = (uint16_t)MIN(me_distortion >> 4, 0xFFFF);
+        sb_stats[sb_index].non_moving_index = parent_pcs_ptr->non_moving_index_array[sb_index];
+    }
+
+    header->frame_count++;
+    encode_context_ptr->first_pass_stats_size += get_record_size(header->sb_count);
+}
+
+EbErrorType two_pass_check_stats(EbSvtAv1EncConfiguration *config) {
+    TwoPassStatsHeader  *header = (TwoPassStatsHeader*)config->rc_stats_buffer.buf;
+
+    if (header == NULL || config->rc_stats_buffer.sz < sizeof(TwoPassStatsHeader))
+        return EB_ErrorBadParameter;
+    if (header->magic != TWO_PASS_STATS_MAGIC || header->version != TWO_PASS_STATS_VERSION)
+        return EB_ErrorBadParameter;
+    if (header->width != config->source_width || header->height != config->source_height || header->frame_count == 0)
+        return EB_ErrorBadParameter;
+    if (config->rc_stats_buffer.sz < sizeof(TwoPassStatsHeader) + header->frame_count * get_record_size(header->sb_count))
+        return EB_ErrorBadParameter;
+    if (config->frames_to_be_encoded > header->frame_count)
+        return EB_ErrorBadParameter;
+
+    return EB_ErrorNone;
+}
+
+EbErrorType two_pass_plan_init(EbRateControlModel *model_ptr, SequenceControlSet_t *sequence_control_set_ptr) {
+    EbSvtAv1EncConfiguration    *config = &sequence_control_set_ptr->static_config;
+    TwoPassStatsHeader          *header = (TwoPassStatsHeader*)config->rc_stats_buffer.buf;
+    uint8_t                     *records;
+    uint64_t                    record_size;
+    uint32_t                    frame_count;
+    uint64_t                    frame_rate = sequence_control_set_ptr->frame_rate > 1000 ?
+                                             sequence_control_set_ptr->frame_rate :
+                                             sequence_control_set_ptr->frame_rate << 16;
+    double                      budget;
+    double                      total_size = 0;
+    int32_t                     qp_offset;
+    uint32_t                    frame_index;
+
+    // The buffer belongs to the application: check it again at its first use,
+    // header (magic, version, size, frame count) and records
+    if (two_pass_check_stats(config) != EB_ErrorNone)
+        return EB_ErrorBadParameter;
+    records = (uint8_t*)config->rc_stats_buffer.buf + sizeof(TwoPassStatsHeader);
+    record_size = get_record_size(header->sb_count);
+    frame_count = header->frame_count;
+    for (frame_index = 0; frame_index < frame_count; frame_index++) {
+        TwoPassFrameStats *frame_stats = (TwoPassFrameStats*)(records + frame_index * record_size);
+
+        if (frame_stats->picture_number >= frame_count || frame_stats->qp > MAX_QP_VALUE)
+            return EB_ErrorBadParameter;
+    }
+    budget = (double)model_ptr->desired_bitrate * frame_count * (1 << 16) / MAX(1, frame_rate);
+
+    EB_MALLOC(uint8_t*, model_ptr->two_pass_qp, sizeof(uint8_t) * frame_count, EB_N_PTR);
+    EB_MALLOC(uint64_t*, model_ptr->two_pass_planned_bits, sizeof(uint64_t) * frame_count, EB_N_PTR);
+    EB_MEMSET(model_ptr->two_pass_qp, 0, sizeof(uint8_t) * frame_count);
+    EB_MEMSET(model_ptr->two_pass_planned_bits, 0, sizeof(uint64_t) * frame_count);
+
+    // The predicted sequence size decreases with the offset: keep the lowest
+    // offset that fits the budget
+    for (qp_offset = -MAX_QP_VALUE; qp_offset <= MAX_QP_VALUE; qp_offset++) {
+        total_size = 0;
+        for (frame_index = 0; frame_index < frame_count; frame_index++) {
+            TwoPassFrameStats *frame_stats = (TwoPassFrameStats*)(records + frame_index * record_size);
+
+            total_size += get_predicted_size(
+                model_ptr,
+                frame_stats,
+                (uint32_t)CLIP3((int32_t)config->min_qp_allowed, (int32_t)config->max_qp_allowed, (int32_t)frame_stats->qp + qp_offset));
+        }
+        if (total_size <= budget)
+            break;
+    }
+    qp_offset = MIN(qp_offset, MAX_QP_VALUE);
+
+    for (frame_index = 0; frame_index < frame_count; frame_index++) {
+        TwoPassFrameStats *frame_stats = (TwoPassFrameStats*)(records + frame_index * record_size);
+        uint32_t qp = (uint32_t)CLIP3((int32_t)config->min_qp_allowed, (int32_t)config->max_qp_allowed, (int32_t)frame_stats->qp + qp_offset);
+
+        if (frame_stats->picture_number < frame_count) {
+            model_ptr->two_pass_qp[frame_stats->picture_number] = (uint8_t)qp;
+            model_ptr->two_pass_planned_bits[frame_stats->picture_number] = (uint64_t)get_predicted_size(model_ptr, frame_stats, qp);
+        }
+    }
+
+    model_ptr->two_pass = EB_TRUE;
+    model_ptr->two_pass_frame_count = frame_count;
+    model_ptr->two_pass_planned_total = 0;
+    model_ptr->two_pass_actual_total = 0;
+
+    SVT_LOG("SVT [two pass]: %u frames, QP offset to the first pass %d, predicted %.0f kbps for a target of %u kbps\n",
+        frame_count, qp_offset,
+        total_size * MAX(1, frame_rate) / (1 << 16) / frame_count / 1000,
+        model_ptr->desired_bitrate / 1000);
+
+    return EB_ErrorNone;
+}
+
+uint8_t rate_control_get_two_pass_quantizer(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr) {
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint64_t                frame_index = MIN(picture_ptr->picture_number, model_ptr->two_pass_frame_count - 1);
+    int64_t                 drift = model_ptr->two_pass_actual_total - model_ptr->two_pass_planned_total;
+    int32_t                 qp_adjust;
+
+    // One QP step per quarter of a second of drift from the plan
+    qp_adjust = (int32_t)CLIP3(-4, 4, (drift * 4) / (int64_t)MAX(1, model_ptr->desired_bitrate));
+
+    return (uint8_t)CLIP3(
+        (int32_t)sequence_control_set_ptr->static_config.min_qp_allowed,
+        (int32_t)sequence_control_set_ptr->static_config.max_qp_allowed,
+        (int32_t)model_ptr->two_pass_qp[frame_index] + qp_adjust);
+}
@@ -0,0 +1,163 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef RateControlTwoPass_h
+#define RateControlTwoPass_h
+
+#include "EbSequenceControlSet.h"
+#include "EbPictureControlSet.h"
+#include "RateControlModel.h"
+
+/*
+ * First pass statistics layout: a TwoPassStatsHeader followed by one record per
+ * encoded frame, in decode order. A record is a TwoPassFrameStats followed by
+ * one TwoPassSbStats per 64x64 super block, in raster scan order.
+ */
+#define TWO_PASS_STATS_MAGIC        0x53325653 // "SV2S"
+#define TWO_PASS_STATS_VERSION      1
+
+/*
+ * @struct Header of the first pass statistics
+ */
+typedef struct TwoPassStatsHeader_s {
+    /*
+     * @variable uint32_t. TWO_PASS_STATS_MAGIC
+     */
+    uint32_t    magic;
+
+    /*
+     * @variable uint32_t. TWO_PASS_STATS_VERSION
+     */
+    uint32_t    version;
+
+    /*
+     * @variable uint32_t. Number of frame records
+     */
+    uint32_t    frame_count;
+
+    /*
+     * @variable uint32_t. Number of super block records per frame
+     */
+    uint32_t    sb_count;
+
+    /*
+     * @variable uint32_t. Source width and height in pixels
+     */
+    uint32_t    width;
+    uint32_t    height;
+
+    /*
+     * @variable uint32_t. Frame rate of the first pass, Q16
+     */
+    uint32_t    frame_rate;
+
+    /*
+     * @variable uint32_t. Unused, zero
+     */
+    uint32_t    reserved;
+} TwoPassStatsHeader;
+
+/*
+ * @struct Per frame first pass statistics
+ */
+typedef struct TwoPassFrameStats_s {
+    /*
+     * @variable uint64_t. Display order of the frame
+     */
+    uint64_t    picture_number;
+
+    /*
+     * @variable uint64_t. Size of the frame coded in the first pass, in bits
+     */
+    uint64_t    total_num_bits;
+
+    /*
+     * @variable uint64_t. Sum of the super block ME distortions
+     */
+    uint64_t    me_distortion;
+
+    /*
+     * @variable uint16_t. Average 64x64 variance and non moving index
+     */
+    uint16_t    pic_avg_variance;
+    uint16_t    non_moving_index_average;
+
+    /*
+     * @variable uint8_t. Frame type and coding parameters of the first pass
+     */
+    uint8_t     slice_type;
+    uint8_t     temporal_layer_index;
+    uint8_t     qp;
+    uint8_t     scene_change_flag;
+    uint8_t     intra_coded_area;
+    uint8_t     reserved[7];
+} TwoPassFrameStats;
+
+/*
+ * @struct Per super block first pass statistics
+ */
+typedef struct TwoPassSbStats_s {
+    /*
+     * @variable uint16_t. ME distortion of the super block, divided by 16 and saturated
+     */
+    uint16_t    me_distortion;
+
+    /*
+     * @variable uint8_t. Non moving index of the super block
+     */
+    uint8_t     non_moving_index;
+    uint8_t     reserved;
+} TwoPassSbStats;
+
+/*
+ * @function two_pass_stats_ctor. Allocate the first pass statistics buffer of
+ * an encoder instance, sized for frames_to_be_encoded records, and write its header.
+ * @param {EncodeContext_t*} encode_context_ptr.
+ * @param {SequenceControlSet_t*} sequence_control_set_ptr.
+ * @return {EbErrorType}.
+ */
+EbErrorType two_pass_stats_ctor(EncodeContext_t *encode_context_ptr,
+                                SequenceControlSet_t *sequence_control_set_ptr);
+
+/*
+ * @function two_pass_record_frame_stats. Append the statistics of a frame coded
+ * in the first pass. Called by the packetization once the frame size is known.
+ * @param {EncodeContext_t*} encode_context_ptr.
+ * @param {PictureControlSet_t*} picture_control_set_ptr. Coded frame.
+ * @return {void}.
+ */
+void two_pass_record_frame_stats(EncodeContext_t *encode_context_ptr,
+                                 PictureControlSet_t *picture_control_set_ptr);
+
+/*
+ * @function two_pass_check_stats. Validate first pass statistics against the
+ * configuration of the second pass.
+ * @param {EbSvtAv1EncConfiguration*} config.
+ * @return {EbErrorType}. EB_ErrorBadParameter when the statistics do not match.
+ */
+EbErrorType two_pass_check_stats(EbSvtAv1EncConfiguration *config);
+
+/*
+ * @function two_pass_plan_init. Allocate the bits of the whole sequence from the
+ * first pass statistics: find the QP offset to the first pass QPs for which the
+ * predicted sequence size meets the target bitrate.
+ * @param {EbRateControlModel*} model_ptr. Initialized model.
+ * @param {SequenceControlSet_t*} sequence_control_set_ptr.
+ * @return {EbErrorType}.
+ */
+EbErrorType two_pass_plan_init(EbRateControlModel *model_ptr,
+                               SequenceControlSet_t *sequence_control_set_ptr);
+
+/*
+ * @function rate_control_get_two_pass_quantizer. Return the planned QP of a frame,
+ * corrected by the drift between the planned and actual sizes reported so far.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {PictureParentControlSet_t*} picture_ptr. Frame to be encoded.
+ * @return {uint8_t}. Suggested QP for the given frame
+ */
+uint8_t rate_control_get_two_pass_quantizer(EbRateControlModel *model_ptr,
+                                            PictureParentControlSet_t *picture_ptr);
+
+#endif // RateControlTwoPass_h
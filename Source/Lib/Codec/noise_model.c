@@ -45,6 +45,15 @@ void pack2d_src(
     uint32_t     height,
     EbAsm      asm_type);
 
+void extract_8bit_data(
+    uint16_t      *in16_bit_buffer,
+    uint32_t       in_stride,
+    uint8_t       *out8_bit_buffer,
+    uint32_t       out8_stride,
+    uint32_t       width,
+    uint32_t       height,
+    EbAsm          asm_type);
+
 // Defines a function that can be used to obtain the mean of a block for the
 // provided data type (uint8_t, or uint16_t)
 #define GET_BLOCK_MEAN(INT_TYPE, suffix)                                    \
@@ -1764,6 +1773,13 @@ int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
         raw_data[2] = sd->bufferCr + sd->strideCr * (sd->origin_y >> chroma_sub_log2[0])
             + (sd->origin_x >> chroma_sub_log2[1]);
     }
+    else if (sd->buffer_16bit_y) {  // 10 bits input kept as 16 bits samples
+        raw_data[0] = (uint8_t *)(sd->buffer_16bit_y + sd->origin_y * sd->stride_y + sd->origin_x);
+        raw_data[1] = (uint8_t *)(sd->buffer_16bit_cb + sd->strideCb * (sd->origin_y >> chroma_sub_log2[0])
+            + (sd->origin_x >> chroma_sub_log2[1]));
+        raw_data[2] = (uint8_t *)(sd->buffer_16bit_cr + sd->strideCr * (sd->origin_y >> chroma_sub_log2[0])
+            + (sd->origin_x >> chroma_sub_log2[1]));
+    }
     else {          // 10 bits input
         pack_2d_pic(sd, ctx->packed, asm_type);
 
@@ -1803,13 +1819,25 @@ int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
         }
         film_grain->apply_grain = 1;
 
-        if (!use_highbd) {
+        if (!use_highbd || sd->buffer_16bit_y) {
             memcpy(raw_data[0], ctx->denoised[0],
                 (strides[0] * sd->height) << use_highbd);
             memcpy(raw_data[1], ctx->denoised[1],
                 (strides[1] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
             memcpy(raw_data[2], ctx->denoised[2],
                 (strides[2] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
+            // Refresh the 8 bits planes used by the analysis
+            if (use_highbd) {
+                extract_8bit_data((uint16_t *)raw_data[0], strides[0],
+                    sd->buffer_y + sd->origin_y * sd->stride_y + sd->origin_x, sd->stride_y,
+                    sd->width, sd->height, asm_type);
+                extract_8bit_data((uint16_t *)raw_data[1], strides[1],
+                    sd->bufferCb + sd->strideCb * (sd->origin_y >> chroma_sub_log2[0]) + (sd->origin_x >> chroma_sub_log2[1]), sd->strideCb,
+                    sd->width >> chroma_sub_log2[1], sd->height >> chroma_sub_log2[0], asm_type);
+                extract_8bit_data((uint16_t *)raw_data[2], strides[2],
+                    sd->bufferCr + sd->strideCr * (sd->origin_y >> chroma_sub_log2[0]) + (sd->origin_x >> chroma_sub_log2[1]), sd->strideCr,
+                    sd->width >> chroma_sub_log2[1], sd->height >> chroma_sub_log2[0], asm_type);
+            }
         }
         else {
             unpack_2d_pic(ctx->denoised, sd, asm_type);
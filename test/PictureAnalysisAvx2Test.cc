@@ -0,0 +1,261 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "EbDefinitions.h"
+
+/*
+ * The AVX2 picture analysis kernels against their C references, on random
+ * input and on the sizes that leave a tail to the scalar loops. The kernels
+ * are reached through the symbols of the shared library, which the Windows
+ * DLL does not export.
+ */
+#ifndef _WIN32
+
+extern "C" {
+EbAsm GetCpuAsmType();
+
+void decimation_2d_fused(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride);
+void decimation_2d_fused_avx2_intrin(
+    uint8_t  *input_samples,
+    uint32_t  input_stride,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint8_t  *quarter_samples,
+    uint32_t  quarter_stride,
+    uint8_t  *sixteenth_samples,
+    uint32_t  sixteenth_stride);
+
+void CalculateHistogram(
+    uint8_t  *input_samples,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint32_t  stride,
+    uint8_t   decimStep,
+    uint32_t *histogram,
+    uint64_t *sum);
+void calculate_histogram_avx2_intrin(
+    uint8_t  *input_samples,
+    uint32_t  input_area_width,
+    uint32_t  input_area_height,
+    uint32_t  stride,
+    uint8_t   decim_step,
+    uint32_t *histogram,
+    uint64_t *sum);
+
+uint32_t compute_histogram_abs_diff(
+    uint32_t *histogram_a,
+    uint32_t *histogram_b,
+    uint32_t  bin_count);
+uint32_t compute_histogram_abs_diff_avx2_intrin(
+    uint32_t *histogram_a,
+    uint32_t *histogram_b,
+    uint32_t  bin_count);
+}
+
+#define TEST_INPUT_PAD      32
+#define TEST_OUTPUT_PAD     16
+#define TEST_OUTPUT_FILL    0xA5
+#define TEST_BIN_COUNT      256
+
+static bool avx2_available() {
+    if (GetCpuAsmType() == ASM_AVX2)
+        return true;
+    printf("AVX2 is not available, test skipped\n");
+    return false;
+}
+
+static void fill_random(std::vector<uint8_t> &buffer, std::mt19937 &rng) {
+    for (size_t i = 0; i < buffer.size(); i++)
+        buffer[i] = (uint8_t)(rng() & 0xFF);
+}
+
+/*
+ * Decimate a random picture with both kernels into outputs filled with the same
+ * pattern, so that the samples written past the picture would also differ.
+ */
+static void check_decimation_2d_fused(
+    uint32_t width,
+    uint32_t height,
+    bool     quarter,
+    bool     sixteenth,
+    std::mt19937 &rng) {
+    const uint32_t input_stride = width + TEST_INPUT_PAD;
+    const uint32_t quarter_stride = (width >> 1) + TEST_OUTPUT_PAD;
+    const uint32_t sixteenth_stride = (width >> 2) + TEST_OUTPUT_PAD;
+    std::vector<uint8_t> input(input_stride * height);
+    std::vector<uint8_t> quarter_ref(quarter_stride * ((height + 1) >> 1), TEST_OUTPUT_FILL);
+    std::vector<uint8_t> quarter_avx2(quarter_ref);
+    std::vector<uint8_t> sixteenth_ref(sixteenth_stride * ((height + 3) >> 2), TEST_OUTPUT_FILL);
+    std::vector<uint8_t> sixteenth_avx2(sixteenth_ref);
+
+    fill_random(input, rng);
+
+    decimation_2d_fused(
+        input.data(), input_stride, width, height,
+        quarter ? quarter_ref.data() : NULL, quarter_stride,
+        sixteenth ? sixteenth_ref.data() : NULL, sixteenth_stride);
+    decimation_2d_fused_avx2_intrin(
+        input.data(), input_stride, width, height,
+        quarter ? quarter_avx2.data() : NULL, quarter_stride,
+        sixteenth ? sixteenth_avx2.data() : NULL, sixteenth_stride);
+
+    EXPECT_TRUE(quarter_ref == quarter_avx2) << "1/4 decimation of " << width << "x" << height;
+    EXPECT_TRUE(sixteenth_ref == sixteenth_avx2) << "1/16 decimation of " << width << "x" << height;
+}
+
+TEST(PictureAnalysisAvx2Test, Decimation2dFused) {
+    // Multiples of the 64 samples of the vector loop, and odd widths and
+    // heights that end in the scalar tail
+    static const uint32_t widths[] = { 64, 128, 320, 2, 7, 63, 65, 130, 333 };
+    static const uint32_t heights[] = { 4, 64, 1, 2, 5, 6, 7, 66 };
+    std::mt19937 rng(0);
+
+    if (!avx2_available())
+        return;
+
+    for (uint32_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        for (uint32_t h = 0; h < sizeof(heights) / sizeof(heights[0]); h++) {
+            check_decimation_2d_fused(widths[w], heights[h], true, true, rng);
+            check_decimation_2d_fused(widths[w], heights[h], true, false, rng);
+            check_decimation_2d_fused(widths[w], heights[h], false, true, rng);
+        }
+    }
+}
+
+/*
+ * Build the histogram of a picture with both kernels, on top of the same
+ * initial bins since the kernels accumulate into the histogram.
+ */
+static void check_calculate_histogram(
+    const std::vector<uint8_t> &input,
+    uint32_t width,
+    uint32_t height,
+    uint32_t stride,
+    uint8_t  decim_step,
+    const std::vector<uint32_t> &initial_histogram) {
+    std::vector<uint32_t> histogram_ref(initial_histogram);
+    std::vector<uint32_t> histogram_avx2(initial_histogram);
+    uint64_t sum_ref = 0;
+    uint64_t sum_avx2 = 1;
+
+    CalculateHistogram(
+        (uint8_t*)input.data(), width, height, stride, decim_step, histogram_ref.data(), &sum_ref);
+    calculate_histogram_avx2_intrin(
+        (uint8_t*)input.data(), width, height, stride, decim_step, histogram_avx2.data(), &sum_avx2);
+
+    EXPECT_TRUE(histogram_ref == histogram_avx2) << "histogram of " << width << "x" << height << " step " << (uint32_t)decim_step;
+    EXPECT_EQ(sum_ref, sum_avx2) << "sum of " << width << "x" << height << " step " << (uint32_t)decim_step;
+}
+
+TEST(PictureAnalysisAvx2Test, CalculateHistogram) {
+    // Multiples of the 32 samples of the vector loop, and widths that end in
+    // the scalar tail
+    static const uint32_t widths[] = { 32, 64, 320, 1, 7, 31, 33, 65, 333 };
+    static const uint32_t heights[] = { 1, 4, 5, 16, 64 };
+    static const uint8_t decim_steps[] = { 1, 2, 4 };
+    std::mt19937 rng(1);
+    std::vector<uint32_t> no_histogram(TEST_BIN_COUNT, 0);
+    std::vector<uint32_t> initial_histogram(TEST_BIN_COUNT);
+
+    if (!avx2_available())
+        return;
+
+    for (uint32_t bin = 0; bin < TEST_BIN_COUNT; bin++)
+        initial_histogram[bin] = rng() & 0xFFFF;
+
+    for (uint32_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+        for (uint32_t h = 0; h < sizeof(heights) / sizeof(heights[0]); h++) {
+            for (uint32_t d = 0; d < sizeof(decim_steps) / sizeof(decim_steps[0]); d++) {
+                const uint32_t stride = widths[w] + TEST_INPUT_PAD;
+                std::vector<uint8_t> input(stride * heights[h] * decim_steps[d]);
+
+                fill_random(input, rng);
+                check_calculate_histogram(input, widths[w], heights[h] * decim_steps[d], stride, decim_steps[d], no_histogram);
+                check_calculate_histogram(input, widths[w], heights[h] * decim_steps[d], stride, decim_steps[d], initial_histogram);
+
+                // Saturated bins: every sample falls in the same bin
+                std::fill(input.begin(), input.end(), (uint8_t)255);
+                check_calculate_histogram(input, widths[w], heights[h] * decim_steps[d], stride, decim_steps[d], no_histogram);
+                std::fill(input.begin(), input.end(), (uint8_t)0);
+                check_calculate_histogram(input, widths[w], heights[h] * decim_steps[d], stride, decim_steps[d], initial_histogram);
+            }
+        }
+    }
+}
+
+TEST(PictureAnalysisAvx2Test, CalculateHistogramMerge) {
+    // The sub-histograms are merged into bins close to wrapping around
+    std::mt19937 rng(2);
+    std::vector<uint8_t> input((64 + TEST_INPUT_PAD) * 64);
+    std::vector<uint32_t> initial_histogram(TEST_BIN_COUNT);
+
+    if (!avx2_available())
+        return;
+
+    for (uint32_t bin = 0; bin < TEST_BIN_COUNT; bin++)
+        initial_histogram[bin] = 0xFFFFFFFF - (rng() & 0xFF);
+
+    fill_random(input, rng);
+    check_calculate_histogram(input, 64, 64, 64 + TEST_INPUT_PAD, 1, initial_histogram);
+    std::fill(input.begin(), input.end(), (uint8_t)128);
+    check_calculate_histogram(input, 64, 64, 64 + TEST_INPUT_PAD, 1, initial_histogram);
+}
+
+static void check_compute_histogram_abs_diff(
+    std::vector<uint32_t> &histogram_a,
+    std::vector<uint32_t> &histogram_b,
+    uint32_t bin_count) {
+    EXPECT_EQ(
+        compute_histogram_abs_diff(histogram_a.data(), histogram_b.data(), bin_count),
+        compute_histogram_abs_diff_avx2_intrin(histogram_a.data(), histogram_b.data(), bin_count))
+        << bin_count << " bins";
+}
+
+TEST(PictureAnalysisAvx2Test, ComputeHistogramAbsDiff) {
+    // Multiples of the 8 bins of the vector loop, and counts that end in the
+    // scalar tail
+    static const uint32_t bin_counts[] = { 0, 1, 7, 8, 9, 63, 64, 65, 255, 256 };
+    std::mt19937 rng(3);
+    std::vector<uint32_t> histogram_a(TEST_BIN_COUNT);
+    std::vector<uint32_t> histogram_b(TEST_BIN_COUNT);
+
+    if (!avx2_available())
+        return;
+
+    for (uint32_t c = 0; c < sizeof(bin_counts) / sizeof(bin_counts[0]); c++) {
+        for (uint32_t bin = 0; bin < TEST_BIN_COUNT; bin++) {
+            histogram_a[bin] = rng() & 0xFFFF;
+            histogram_b[bin] = rng() & 0xFFFF;
+        }
+        check_compute_histogram_abs_diff(histogram_a, histogram_b, bin_counts[c]);
+
+        // Saturated bins: the largest differences the signed bin difference
+        // holds, in both directions, with a sum that wraps around
+        for (uint32_t bin = 0; bin < TEST_BIN_COUNT; bin++) {
+            histogram_a[bin] = (bin & 1) ? 0x7FFFFFFF : 0;
+            histogram_b[bin] = (bin & 1) ? 0 : 0x7FFFFFFF;
+        }
+        check_compute_histogram_abs_diff(histogram_a, histogram_b, bin_counts[c]);
+
+        // Identical histograms
+        check_compute_histogram_abs_diff(histogram_a, histogram_a, bin_counts[c]);
+    }
+}
+
+#endif
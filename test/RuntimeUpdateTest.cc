@@ -0,0 +1,132 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+#include "EbSvtAv1Enc.h"
+
+#define TEST_WIDTH          320
+#define TEST_HEIGHT         240
+#define TEST_FRAME_COUNT    60
+#define TEST_UPDATE_FRAME   20
+#define TEST_SETTLED_FRAME  40
+#define TEST_BIT_RATE       2000000
+#define TEST_UPDATE_BIT_RATE 100000
+
+/*
+ * Encode a short synthetic clip, optionally dropping the preset and the target
+ * bit rate at TEST_UPDATE_FRAME with eb_svt_enc_update_parameter. Every picture
+ * must come out as one packet, the last one carrying the EOS flag. Returns the
+ * number of bytes of the pictures from TEST_SETTLED_FRAME on, once the rate
+ * control had the time to follow the update.
+ */
+static uint64_t encode_with_runtime_update(uint8_t pred_structure, bool update) {
+    EbComponentType             *handle = NULL;
+    EbSvtAv1EncConfiguration    config;
+    EbSvtIOFormat               planes;
+    EbBufferHeaderType          input;
+    EbBufferHeaderType          *output = NULL;
+    uint8_t                     *yuv = (uint8_t*)malloc(TEST_WIDTH * TEST_HEIGHT * 3 / 2);
+    uint32_t                    packet_count = 0;
+    uint32_t                    noise = 1;
+    uint64_t                    settled_bytes = 0;
+    EbBool                      eos = EB_FALSE;
+
+    EXPECT_TRUE(yuv != NULL);
+    if (yuv == NULL)
+        return 0;
+    EXPECT_EQ(EB_ErrorNone, eb_init_handle(&handle, NULL, &config));
+
+    config.source_width = TEST_WIDTH;
+    config.source_height = TEST_HEIGHT;
+    config.frames_to_be_encoded = TEST_FRAME_COUNT;
+    config.frame_rate = 30;
+    config.enc_mode = MAX_ENC_PRESET;
+    config.pred_structure = pred_structure;
+    config.rate_control_mode = 2;
+    config.target_bit_rate = TEST_BIT_RATE;
+    EXPECT_EQ(EB_ErrorNone, eb_svt_enc_set_parameter(handle, &config));
+    EXPECT_EQ(EB_ErrorNone, eb_init_encoder(handle));
+
+    memset(&planes, 0, sizeof(planes));
+    planes.luma = yuv;
+    planes.cb = yuv + TEST_WIDTH * TEST_HEIGHT;
+    planes.cr = planes.cb + TEST_WIDTH * TEST_HEIGHT / 4;
+    planes.yStride = TEST_WIDTH;
+    planes.cbStride = TEST_WIDTH >> 1;
+    planes.crStride = TEST_WIDTH >> 1;
+
+    memset(&input, 0, sizeof(input));
+    input.size = sizeof(input);
+    input.p_buffer = (uint8_t*)&planes;
+    input.n_filled_len = TEST_WIDTH * TEST_HEIGHT * 3 / 2;
+    input.pic_type = EB_AV1_INVALID_PICTURE;
+
+    for (uint32_t frame = 0; frame < TEST_FRAME_COUNT; frame++) {
+        // A moving gradient with some noise, so that the bit rate matters
+        for (uint32_t i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+            noise = noise * 1103515245 + 12345;
+            yuv[i] = (uint8_t)((i % TEST_WIDTH) + (i / TEST_WIDTH) + 4 * frame + ((noise >> 16) & 15));
+        }
+        memset(planes.cb, 128, TEST_WIDTH * TEST_HEIGHT / 2);
+
+        if (update && frame == TEST_UPDATE_FRAME) {
+            // Also re-pin the encoder threads to a single logical processor
+            config.enc_mode = 5;
+            config.target_bit_rate = TEST_UPDATE_BIT_RATE;
+            config.logical_processors = 1;
+            EXPECT_EQ(EB_ErrorNone, eb_svt_enc_update_parameter(handle, &config));
+        }
+
+        input.pts = frame;
+        input.flags = 0;
+        EXPECT_EQ(EB_ErrorNone, eb_svt_enc_send_picture(handle, &input));
+    }
+
+    // Out of range presets are refused and leave the encoder running
+    config.enc_mode = MAX_ENC_PRESET + 1;
+    EXPECT_EQ(EB_ErrorBadParameter, eb_svt_enc_update_parameter(handle, &config));
+
+    input.p_buffer = NULL;
+    input.n_filled_len = 0;
+    input.flags = EB_BUFFERFLAG_EOS;
+    EXPECT_EQ(EB_ErrorNone, eb_svt_enc_send_picture(handle, &input));
+
+    while (!eos) {
+        EbErrorType return_error = eb_svt_get_packet(handle, &output, 1);
+        EXPECT_NE(EB_ErrorMax, return_error);
+        if (return_error == EB_ErrorMax)
+            break;
+        if (return_error == EB_NoErrorEmptyQueue)
+            continue;
+        eos = (output->flags & EB_BUFFERFLAG_EOS) ? EB_TRUE : EB_FALSE;
+        EXPECT_GT(output->n_filled_len, 0u);
+        packet_count++;
+        if (output->pts >= TEST_SETTLED_FRAME)
+            settled_bytes += output->n_filled_len;
+        eb_svt_release_out_buffer(&output);
+    }
+    EXPECT_TRUE(eos);
+    EXPECT_EQ((uint32_t)TEST_FRAME_COUNT, packet_count);
+
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(handle));
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(handle));
+    free(yuv);
+
+    return settled_bytes;
+}
+
+TEST(RuntimeUpdateTest, RandomAccess) {
+    const uint64_t unchanged_bytes = encode_with_runtime_update(2, false);
+    const uint64_t updated_bytes = encode_with_runtime_update(2, true);
+    EXPECT_LT(updated_bytes, unchanged_bytes);
+}
+
+TEST(RuntimeUpdateTest, LowDelayP) {
+    const uint64_t unchanged_bytes = encode_with_runtime_update(0, false);
+    const uint64_t updated_bytes = encode_with_runtime_update(0, true);
+    EXPECT_LT(updated_bytes, unchanged_bytes);
+}